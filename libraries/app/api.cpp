@@ -35,6 +35,7 @@
 #include <graphene/chain/transaction_history_object.hpp>
 #include <graphene/chain/withdraw_permission_object.hpp>
 #include <graphene/chain/worker_object.hpp>
+#include <graphene/market_history/fill_store.hpp>
 
 #include <fc/crypto/base64.hpp>
 #include <fc/crypto/hex.hpp>
@@ -326,6 +327,11 @@ namespace graphene { namespace app {
        asset_id_type a = database_api.get_asset_id_from_string( asset_a );
        asset_id_type b = database_api.get_asset_id_from_string( asset_b );
        if( a > b ) std::swap(a,b);
+
+       const auto* store = market_hist_plugin->get_fill_store();
+       if( store != nullptr )
+          return store->get_fills( a, b, limit );
+
        const auto& history_idx = db.get_index_type<graphene::market_history::history_index>().indices().get<by_key>();
        history_key hkey;
        hkey.base = a;
@@ -538,6 +544,10 @@ namespace graphene { namespace app {
 
        if( a > b ) std::swap(a,b);
 
+       const auto* store = market_hist_plugin->get_fill_store();
+       if( store != nullptr )
+          return store->get_buckets( a, b, bucket_seconds, start, end, 200 );
+
        const auto& bidx = db.get_index_type<bucket_index>();
        const auto& by_key_idx = bidx.indices().get<by_key>();
 
@@ -755,23 +765,22 @@ namespace graphene { namespace app {
                   ("configured_limit", configured_limit) );
 
        asset_id_type asset_id = database_api.get_asset_id_from_string( asset );
-       const auto& bal_idx = _db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
-       auto range = bal_idx.equal_range( boost::make_tuple( asset_id ) );
+       const auto& bal_idx = _db.get_index_type< primary_index< account_balance_index > >()
+                               .get_secondary_index< balances_by_asset_index >().get_balances_by_asset();
+
+       // zero balances are sorted after all holders of the asset
+       const auto first = bal_idx.rank( bal_idx.lower_bound( boost::make_tuple( asset_id ) ) );
+       const auto end = bal_idx.lower_bound( boost::make_tuple( asset_id, share_type(0) ) );
+       const auto holders = bal_idx.rank( end ) - first;
 
        vector<account_asset_balance> result;
+       if( start >= holders )
+          return result;
+       result.reserve( std::min<size_t>( limit, holders - start ) );
 
-       uint32_t index = 0;
-       for( const account_balance_object& bal : boost::make_iterator_range( range.first, range.second ) )
+       for( auto itr = bal_idx.nth( first + start ); itr != end && result.size() < limit; ++itr )
        {
-          if( result.size() >= limit )
-             break;
-
-          if( bal.balance.value == 0 )
-             continue;
-
-          if( index++ < start )
-             continue;
-
+          const asset_balance_entry& bal = *itr;
           const auto account = _db.find(bal.owner);
 
           account_asset_balance aab;
@@ -786,11 +795,12 @@ namespace graphene { namespace app {
     }
     // get number of asset holders.
     int asset_api::get_asset_holders_count( std::string asset ) const {
-       const auto& bal_idx = _db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
+       const auto& bal_idx = _db.get_index_type< primary_index< account_balance_index > >()
+                               .get_secondary_index< balances_by_asset_index >().get_balances_by_asset();
        asset_id_type asset_id = database_api.get_asset_id_from_string( asset );
        auto range = bal_idx.equal_range( boost::make_tuple( asset_id ) );
 
-       int count = boost::distance(range) - 1;
+       int count = static_cast<int>( bal_idx.rank( range.second ) - bal_idx.rank( range.first ) ) - 1;
 
        return count;
     }
@@ -805,10 +815,11 @@ namespace graphene { namespace app {
           asset_id_type asset_id;
           asset_id = dasset_obj.id;
 
-          const auto& bal_idx = _db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
+          const auto& bal_idx = _db.get_index_type< primary_index< account_balance_index > >()
+                               .get_secondary_index< balances_by_asset_index >().get_balances_by_asset();
           auto range = bal_idx.equal_range( boost::make_tuple( asset_id ) );
 
-          int count = boost::distance(range) - 1;
+          int count = static_cast<int>( bal_idx.rank( range.second ) - bal_idx.rank( range.first ) ) - 1;
 
           asset_holders ah;
           ah.asset_id       = asset_id;
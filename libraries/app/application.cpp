@@ -295,6 +295,12 @@ void application_impl::initialize(const fc::path& data_dir, shared_ptr<boost::pr
    }
 
    initialize_plugins();
+
+   if( _app_options.has_market_history_plugin )
+   {
+      auto market_history = _self.get_plugin<graphene::market_history::market_history_plugin>( "market_history" );
+      _app_options.market_history_fill_store = market_history->get_fill_store();
+   }
 }
 
 void application_impl::set_api_limit() {
@@ -514,6 +520,11 @@ void application_impl::open_chain_database() const
       _chain_db->enable_standby_votes_tracking( _options->at("enable-standby-votes-tracking").as<bool>() );
    }
 
+   if( _options->count("fork-db-max-memory") > 0 )
+   {
+      _chain_db->set_fork_db_max_memory( _options->at("fork-db-max-memory").as<uint64_t>() );
+   }
+
    if( _options->count("replay-blockchain") > 0 || _options->count("revalidate-blockchain") > 0 )
       _chain_db->wipe( _data_dir / "blockchain", false );
 
@@ -546,6 +557,10 @@ void application_impl::open_chain_database() const
       graphene::chain::detail::with_skip_flags( *_chain_db, skip, [this, &genesis_loader] () {
          _chain_db->open( _data_dir / "blockchain", genesis_loader, GRAPHENE_CURRENT_DB_VERSION );
       });
+
+      // enabled after a replay, which does not need to maintain it
+      if( _options->count("enable-state-digest") > 0 && _options->at("enable-state-digest").as<bool>() )
+         _chain_db->enable_state_digest( true );
    }
    catch( const fc::exception& e )
    {
@@ -1166,6 +1181,12 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("enable-standby-votes-tracking", bpo::value<bool>()->implicit_value(true),
           "Whether to enable tracking of votes of standby witnesses and committee members. "
           "Set it to true to provide accurate data to API clients, set to false for slightly better performance.")
+         ("fork-db-max-memory", bpo::value<uint64_t>()->default_value(0),
+          "Approximate limit of memory in bytes used by blocks in the fork database. When exceeded, blocks not on "
+          "the current chain are dropped, oldest forks first. 0 means no limit")
+         ("enable-state-digest", bpo::value<bool>()->implicit_value(true),
+          "Whether to maintain a digest of the chain state, available through database_api::get_state_digest. "
+          "It allows comparing the state of nodes, at the cost of hashing every changed object.")
          ("api-limit-get-account-history-operations",
           bpo::value<uint64_t>()->default_value(default_opts.api_limit_get_account_history_operations),
           "For history_api::get_account_history_operations to set max limit value")
@@ -27,6 +27,7 @@
 #include <graphene/app/util.hpp>
 #include <graphene/chain/get_config.hpp>
 #include <graphene/chain/hardfork.hpp>
+#include <graphene/market_history/fill_store.hpp>
 #include <graphene/protocol/pts_address.hpp>
 #include <graphene/protocol/restriction_predicate.hpp>
 
@@ -329,6 +330,32 @@ dynamic_global_property_object database_api_impl::get_dynamic_global_properties(
    return _db.get(dynamic_global_property_id_type());
 }
 
+optional<fc::sha256> database_api::get_state_digest()const
+{
+   return my->get_state_digest();
+}
+
+optional<fc::sha256> database_api_impl::get_state_digest()const
+{
+   return _db.get_state_digest();
+}
+
+fork_database_info database_api::get_fork_database_info()const
+{
+   return my->get_fork_database_info();
+}
+
+fork_database_info database_api_impl::get_fork_database_info()const
+{
+   const fork_database& fork_db = _db.get_fork_db();
+   fork_database_info info;
+   info.blocks = fork_db.size();
+   info.memory_usage = fork_db.memory_usage();
+   info.max_memory = fork_db.max_memory();
+   info.pruned_blocks = fork_db.pruned_blocks();
+   return info;
+}
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // Keys                                                             //
@@ -1529,71 +1556,82 @@ vector<market_trade> database_api_impl::get_trade_history( const string& base,
    if ( start.sec_since_epoch() == 0 )
       start = fc::time_point_sec( fc::time_point::now() );
 
-   uint32_t count = 0;
-   const auto& history_idx = _db.get_index_type<market_history::history_index>().indices().get<by_market_time>();
-   auto itr = history_idx.lower_bound( std::make_tuple( base_id, quote_id, start ) );
-   vector<market_trade> result;
+   // fills of the market, newest first
+   auto collect_trades = [&]( auto itr, auto end ) {
+      uint32_t count = 0;
+      vector<market_trade> result;
 
-   while( itr != history_idx.end() && count < limit
-          && !( itr->key.base != base_id || itr->key.quote != quote_id || itr->time < stop ) )
-   {
+      while( itr != end && count < limit
+             && !( itr->key.base != base_id || itr->key.quote != quote_id || itr->time < stop ) )
       {
-         market_trade trade;
-
-         if( assets[0]->id == itr->op.receives.asset_id )
          {
-            trade.amount = assets[1]->amount_to_string( itr->op.pays );
-            trade.value = assets[0]->amount_to_string( itr->op.receives );
-         }
-         else
-         {
-            trade.amount = assets[1]->amount_to_string( itr->op.receives );
-            trade.value = assets[0]->amount_to_string( itr->op.pays );
-         }
-
-         trade.date = itr->time;
-         trade.price = price_to_string( itr->op.fill_price, *assets[0], *assets[1] );
+            market_trade trade;
 
-         if( itr->op.is_maker )
-         {
-            trade.sequence = -itr->key.sequence;
-            trade.side1_account_id = itr->op.account_id;
-            if(itr->op.receives.asset_id == assets[0]->id)
-               trade.type = "sell";
+            if( assets[0]->id == itr->op.receives.asset_id )
+            {
+               trade.amount = assets[1]->amount_to_string( itr->op.pays );
+               trade.value = assets[0]->amount_to_string( itr->op.receives );
+            }
             else
-               trade.type = "buy";
-         }
-         else
-            trade.side2_account_id = itr->op.account_id;
-
-         auto next_itr = std::next(itr);
-         // Trades are usually tracked in each direction, exception: for global settlement only one side is recorded
-         if( next_itr != history_idx.end() && next_itr->key.base == base_id && next_itr->key.quote == quote_id
-             && next_itr->time == itr->time && next_itr->op.is_maker != itr->op.is_maker )
-         {  // next_itr now could be the other direction // FIXME not 100% sure
-            if( next_itr->op.is_maker )
             {
-               trade.sequence = -next_itr->key.sequence;
-               trade.side1_account_id = next_itr->op.account_id;
-               if(next_itr->op.receives.asset_id == assets[0]->id)
+               trade.amount = assets[1]->amount_to_string( itr->op.receives );
+               trade.value = assets[0]->amount_to_string( itr->op.pays );
+            }
+
+            trade.date = itr->time;
+            trade.price = price_to_string( itr->op.fill_price, *assets[0], *assets[1] );
+
+            if( itr->op.is_maker )
+            {
+               trade.sequence = -itr->key.sequence;
+               trade.side1_account_id = itr->op.account_id;
+               if(itr->op.receives.asset_id == assets[0]->id)
                   trade.type = "sell";
                else
                   trade.type = "buy";
             }
             else
-               trade.side2_account_id = next_itr->op.account_id;
-            // skip the other direction
-            itr = next_itr;
+               trade.side2_account_id = itr->op.account_id;
+
+            auto next_itr = std::next(itr);
+            // Trades are usually tracked in each direction, exception: for global settlement only one side is recorded
+            if( next_itr != end && next_itr->key.base == base_id && next_itr->key.quote == quote_id
+                && next_itr->time == itr->time && next_itr->op.is_maker != itr->op.is_maker )
+            {  // next_itr now could be the other direction // FIXME not 100% sure
+               if( next_itr->op.is_maker )
+               {
+                  trade.sequence = -next_itr->key.sequence;
+                  trade.side1_account_id = next_itr->op.account_id;
+                  if(next_itr->op.receives.asset_id == assets[0]->id)
+                     trade.type = "sell";
+                  else
+                     trade.type = "buy";
+               }
+               else
+                  trade.side2_account_id = next_itr->op.account_id;
+               // skip the other direction
+               itr = next_itr;
+            }
+
+            result.push_back( trade );
+            ++count;
          }
 
-         result.push_back( trade );
-         ++count;
+         ++itr;
       }
 
-      ++itr;
+      return result;
+   };
+
+   const auto* store = _app_options->market_history_fill_store;
+   if( store != nullptr )
+   {
+      const auto fills = store->get_fills( base_id, quote_id, 2 * limit + 1, start, stop );
+      return collect_trades( fills.begin(), fills.end() );
    }
 
-   return result;
+   const auto& history_idx = _db.get_index_type<market_history::history_index>().indices().get<by_market_time>();
+   return collect_trades( history_idx.lower_bound( std::make_tuple( base_id, quote_id, start ) ), history_idx.end() );
 }
 
 vector<market_trade> database_api::get_trade_history_by_sequence(
@@ -1631,87 +1669,100 @@ vector<market_trade> database_api_impl::get_trade_history_by_sequence(
    auto quote_id = assets[1]->id;
 
    if( base_id > quote_id ) std::swap( base_id, quote_id );
-   const auto& history_idx = _db.get_index_type<graphene::market_history::history_index>().indices().get<by_key>();
-   history_key hkey;
-   hkey.base = base_id;
-   hkey.quote = quote_id;
-   hkey.sequence = start_seq;
 
-   uint32_t count = 0;
-   auto itr = history_idx.lower_bound( hkey );
-   vector<market_trade> result;
+   // fills of the market, newest first
+   auto collect_trades = [&]( auto itr, auto end ) {
+      uint32_t count = 0;
+      vector<market_trade> result;
 
-   while( itr != history_idx.end() && count < limit
-          && !( itr->key.base != base_id || itr->key.quote != quote_id || itr->time < stop ) )
-   {
-      if( itr->key.sequence == start_seq ) // found the key, should skip this and the other direction if found
-      {
-         auto next_itr = std::next(itr);
-         if( next_itr != history_idx.end() && next_itr->key.base == base_id && next_itr->key.quote == quote_id
-             && next_itr->time == itr->time && next_itr->op.is_maker != itr->op.is_maker )
-         {  // next_itr now could be the other direction // FIXME not 100% sure
-            // skip the other direction
-            itr = next_itr;
-         }
-      }
-      else
+      while( itr != end && count < limit
+             && !( itr->key.base != base_id || itr->key.quote != quote_id || itr->time < stop ) )
       {
-         market_trade trade;
-
-         if( assets[0]->id == itr->op.receives.asset_id )
+         if( itr->key.sequence == start_seq ) // found the key, should skip this and the other direction if found
          {
-            trade.amount = assets[1]->amount_to_string( itr->op.pays );
-            trade.value = assets[0]->amount_to_string( itr->op.receives );
+            auto next_itr = std::next(itr);
+            if( next_itr != end && next_itr->key.base == base_id && next_itr->key.quote == quote_id
+                && next_itr->time == itr->time && next_itr->op.is_maker != itr->op.is_maker )
+            {  // next_itr now could be the other direction // FIXME not 100% sure
+               // skip the other direction
+               itr = next_itr;
+            }
          }
          else
          {
-            trade.amount = assets[1]->amount_to_string( itr->op.receives );
-            trade.value = assets[0]->amount_to_string( itr->op.pays );
-         }
+            market_trade trade;
 
-         trade.date = itr->time;
-         trade.price = price_to_string( itr->op.fill_price, *assets[0], *assets[1] );
-
-         if( itr->op.is_maker )
-         {
-            trade.sequence = -itr->key.sequence;
-            trade.side1_account_id = itr->op.account_id;
-            if(itr->op.receives.asset_id == assets[0]->id)
-               trade.type = "sell";
+            if( assets[0]->id == itr->op.receives.asset_id )
+            {
+               trade.amount = assets[1]->amount_to_string( itr->op.pays );
+               trade.value = assets[0]->amount_to_string( itr->op.receives );
+            }
             else
-               trade.type = "buy";
-         }
-         else
-            trade.side2_account_id = itr->op.account_id;
-
-         auto next_itr = std::next(itr);
-         // Trades are usually tracked in each direction, exception: for global settlement only one side is recorded
-         if( next_itr != history_idx.end() && next_itr->key.base == base_id && next_itr->key.quote == quote_id
-             && next_itr->time == itr->time && next_itr->op.is_maker != itr->op.is_maker )
-         {  // next_itr now could be the other direction // FIXME not 100% sure
-            if( next_itr->op.is_maker )
             {
-               trade.sequence = -next_itr->key.sequence;
-               trade.side1_account_id = next_itr->op.account_id;
-               if(next_itr->op.receives.asset_id == assets[0]->id)
+               trade.amount = assets[1]->amount_to_string( itr->op.receives );
+               trade.value = assets[0]->amount_to_string( itr->op.pays );
+            }
+
+            trade.date = itr->time;
+            trade.price = price_to_string( itr->op.fill_price, *assets[0], *assets[1] );
+
+            if( itr->op.is_maker )
+            {
+               trade.sequence = -itr->key.sequence;
+               trade.side1_account_id = itr->op.account_id;
+               if(itr->op.receives.asset_id == assets[0]->id)
                   trade.type = "sell";
                else
                   trade.type = "buy";
             }
             else
-               trade.side2_account_id = next_itr->op.account_id;
-            // skip the other direction
-            itr = next_itr;
+               trade.side2_account_id = itr->op.account_id;
+
+            auto next_itr = std::next(itr);
+            // Trades are usually tracked in each direction, exception: for global settlement only one side is recorded
+            if( next_itr != end && next_itr->key.base == base_id && next_itr->key.quote == quote_id
+                && next_itr->time == itr->time && next_itr->op.is_maker != itr->op.is_maker )
+            {  // next_itr now could be the other direction // FIXME not 100% sure
+               if( next_itr->op.is_maker )
+               {
+                  trade.sequence = -next_itr->key.sequence;
+                  trade.side1_account_id = next_itr->op.account_id;
+                  if(next_itr->op.receives.asset_id == assets[0]->id)
+                     trade.type = "sell";
+                  else
+                     trade.type = "buy";
+               }
+               else
+                  trade.side2_account_id = next_itr->op.account_id;
+               // skip the other direction
+               itr = next_itr;
+            }
+
+            result.push_back( trade );
+            ++count;
          }
 
-         result.push_back( trade );
-         ++count;
+         ++itr;
       }
 
-      ++itr;
+      return result;
+   };
+
+   const auto* store = _app_options->market_history_fill_store;
+   if( store != nullptr )
+   {
+      const auto fills = store->get_fills( base_id, quote_id, 2 * limit + 2, fc::time_point_sec::maximum(), stop,
+                                           start_seq );
+      return collect_trades( fills.begin(), fills.end() );
    }
 
-   return result;
+   const auto& history_idx = _db.get_index_type<graphene::market_history::history_index>().indices().get<by_key>();
+   history_key hkey;
+   hkey.base = base_id;
+   hkey.quote = quote_id;
+   hkey.sequence = start_seq;
+
+   return collect_trades( history_idx.lower_bound( hkey ), history_idx.end() );
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -197,6 +197,7 @@ namespace graphene { namespace app {
           * @param b The other asset symbol or ID in the trading pair
           * @param limit Maximum records to return
           * @return a list of order_history objects, in "most recent first" order
+          * Note: if the API server keeps a fill store, executions from before the store was enabled are not returned
           */
          vector<order_history_object> get_fill_order_history( std::string a, std::string b, uint32_t limit )const;
 
@@ -205,7 +206,9 @@ namespace graphene { namespace app {
           * @param a Asset symbol or ID in a trading pair
           * @param b The other asset symbol or ID in the trading pair
           * @param bucket_seconds Length of each time bucket in seconds.
-          * Note: it need to be within result of get_market_history_buckets() API, otherwise no data will be returned
+          * Note: it need to be within result of get_market_history_buckets() API, otherwise no data will be returned,
+          * unless the API server keeps a fill store, which supports any bucket length, but does not return data from
+          * before the store was enabled
           * @param start The start of a time range, E.G. "2018-01-01T00:00:00"
           * @param end The end of the time range
           * @return A list of OHLCV data, in "least recent first" order.
@@ -162,6 +162,14 @@ namespace graphene { namespace app {
       optional<liquidity_pool_ticker_object> statistics;
    };
 
+   struct fork_database_info
+   {
+      uint32_t                   blocks = 0;        ///< Number of blocks held
+      uint64_t                   memory_usage = 0;  ///< Total packed size of the blocks, in bytes
+      uint64_t                   max_memory = 0;    ///< Limit set by the fork-db-max-memory option, 0 for none
+      uint64_t                   pruned_blocks = 0; ///< Blocks of other forks dropped since the node started
+   };
+
 } }
 
 FC_REFLECT( graphene::app::more_data,
@@ -206,3 +214,4 @@ FC_REFLECT_DERIVED( graphene::app::extended_asset_object, (graphene::chain::asse
 FC_REFLECT_DERIVED( graphene::app::extended_liquidity_pool_object, (graphene::chain::liquidity_pool_object),
                     (statistics) )
 
+FC_REFLECT( graphene::app::fork_database_info, (blocks)(memory_usage)(max_memory)(pruned_blocks) )
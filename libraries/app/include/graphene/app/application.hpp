@@ -29,6 +29,8 @@
 
 #include <boost/program_options.hpp>
 
+namespace graphene { namespace market_history { class fill_store; } }
+
 namespace graphene { namespace app {
    namespace detail { class application_impl; }
    using std::string;
@@ -42,6 +44,8 @@ namespace graphene { namespace app {
 
          bool has_api_helper_indexes_plugin = false;
          bool has_market_history_plugin = false;
+         /// The fill store of the market history plugin if it is enabled, trade history is then served from it
+         const graphene::market_history::fill_store* market_history_fill_store = nullptr;
 
          uint64_t api_limit_get_account_history_operations = 100;
          uint64_t api_limit_get_account_history = 100;
@@ -220,6 +220,17 @@ class database_api
        */
       dynamic_global_property_object get_dynamic_global_properties()const;
 
+      /**
+       * @brief Get a digest of the current chain state, which is the same on all nodes holding the same state
+       * @return the digest, or null if the node was not started with the @a enable-state-digest option
+       */
+      optional<fc::sha256> get_state_digest()const;
+
+      /**
+       * @brief Get the number of blocks held in the fork database, their memory usage and how many were pruned
+       */
+      fork_database_info get_fork_database_info()const;
+
       //////////
       // Keys //
       //////////
@@ -1364,6 +1375,8 @@ FC_API(graphene::app::database_api,
    (get_config)
    (get_chain_id)
    (get_dynamic_global_properties)
+   (get_state_digest)
+   (get_fork_database_info)
 
    // Keys
    (get_key_references)
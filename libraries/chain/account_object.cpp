@@ -27,6 +27,8 @@
 #include <fc/io/raw.hpp>
 #include <fc/uint128.hpp>
 
+#include <algorithm>
+
 namespace graphene { namespace chain {
 
 share_type cut_fee(share_type a, uint16_t p)
@@ -299,6 +301,119 @@ const account_balance_object* balances_by_account_index::get_account_balance( co
    return itr->second;
 }
 
+asset_balance_entry balances_by_asset_index::make_entry( const object& obj )
+{
+   const auto& abo = static_cast< const account_balance_object& >( obj );
+   return asset_balance_entry{ abo.asset_type, abo.balance, abo.owner };
+}
+
+void balances_by_asset_index::object_inserted( const object& obj )
+{
+   // an object removed and inserted again keeps its old entry, e.g. when a removal is undone
+   pending_changes[ obj.id.instance() ].new_entry = make_entry( obj );
+}
+
+void balances_by_asset_index::object_removed( const object& obj )
+{
+   auto itr = pending_changes.find( obj.id.instance() );
+   if( itr == pending_changes.end() )
+      pending_changes[ obj.id.instance() ].old_entry = make_entry( obj );
+   else
+      itr->second.new_entry.reset();
+}
+
+void balances_by_asset_index::about_to_modify( const object& before )
+{
+   auto itr = pending_changes.find( before.id.instance() );
+   if( itr == pending_changes.end() )
+   {
+      pending_change& change = pending_changes[ before.id.instance() ];
+      change.old_entry = make_entry( before );
+      change.new_entry = change.old_entry;
+   }
+}
+
+void balances_by_asset_index::object_modified( const object& after )
+{
+   pending_changes[ after.id.instance() ].new_entry = make_entry( after );
+}
+
+void balances_by_asset_index::apply_pending_changes()const
+{
+   for( const auto& item : pending_changes )
+   {
+      const pending_change& change = item.second;
+      if( change.old_entry.valid() == change.new_entry.valid()
+            && ( !change.old_entry.valid() || *change.old_entry == *change.new_entry ) )
+         continue;
+      auto& idx = ordered.get<by_asset_balance>();
+      if( change.old_entry.valid() )
+      {
+         auto itr = idx.find( boost::make_tuple( change.old_entry->asset_type, change.old_entry->balance,
+                                                 change.old_entry->owner ) );
+         FC_ASSERT( itr != idx.end(), "Balance of ${o} in ${a} is missing",
+                    ("o",change.old_entry->owner)("a",change.old_entry->asset_type) );
+         idx.erase( itr );
+      }
+      if( change.new_entry.valid() )
+         FC_ASSERT( ordered.insert( *change.new_entry ).second, "Duplicate balance of ${o} in ${a}",
+                    ("o",change.new_entry->owner)("a",change.new_entry->asset_type) );
+   }
+   pending_changes.clear();
+}
+
+const asset_balance_multi_index_type::index<by_asset_balance>::type&
+balances_by_asset_index::get_balances_by_asset()const
+{
+   if( !pending_changes.empty() )
+      apply_pending_changes();
+   return ordered.get<by_asset_balance>();
+}
+
+void flagged_balances_index::add( const object& obj )
+{
+   const auto& abo = static_cast< const account_balance_object& >( obj );
+   if( !abo.maintenance_flag )
+      return;
+   const uint64_t instance = abo.id.instance();
+   if( is_flagged.size() <= instance )
+      is_flagged.resize( instance + 1 );
+   if( is_flagged[instance] )
+      return;
+   is_flagged[instance] = true;
+   if( !flagged.empty() && flagged.back() > instance )
+      sorted = false;
+   flagged.push_back( instance );
+}
+
+void flagged_balances_index::object_inserted( const object& obj )
+{
+   add( obj );
+}
+
+void flagged_balances_index::object_modified( const object& after )
+{
+   add( after );
+}
+
+const vector< uint64_t >& flagged_balances_index::get_flagged_balances()
+{
+   if( !sorted )
+   {
+      std::sort( flagged.begin(), flagged.end() );
+      sorted = true;
+   }
+   return flagged;
+}
+
+void flagged_balances_index::clear()
+{
+   for( const uint64_t instance : flagged )
+      is_flagged[instance] = false;
+   flagged.clear();
+   sorted = true;
+}
+
 } } // graphene::chain
 
 FC_REFLECT_DERIVED_NO_TYPENAME( graphene::chain::account_object,
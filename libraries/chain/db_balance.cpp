@@ -34,8 +34,7 @@ namespace graphene { namespace chain {
 
 asset database::get_balance(account_id_type owner, asset_id_type asset_id) const
 {
-   auto& index = get_index_type< primary_index< account_balance_index > >().get_secondary_index<balances_by_account_index>();
-   auto abo = index.get_account_balance( owner, asset_id );
+   auto abo = _balances_by_account->get_account_balance( owner, asset_id );
    if( !abo )
       return asset(0, asset_id);
    return abo->get_balance();
@@ -56,15 +55,14 @@ void database::adjust_balance(account_id_type account, asset delta )
    if( delta.amount == 0 )
       return;
 
-   auto& index = get_index_type< primary_index< account_balance_index > >().get_secondary_index<balances_by_account_index>();
-   auto abo = index.get_account_balance( account, delta.asset_id );
+   auto abo = _balances_by_account->get_account_balance( account, delta.asset_id );
    if( !abo )
    {
       FC_ASSERT( delta.amount > 0, "Insufficient Balance: ${a}'s balance of ${b} is less than required ${r}", 
                  ("a",account(*this).name)
                  ("b",to_pretty_string(asset(0,delta.asset_id)))
                  ("r",to_pretty_string(-delta)));
-      create<account_balance_object>([account,&delta](account_balance_object& b) {
+      create_in< primary_index< account_balance_index > >([account,&delta](account_balance_object& b) {
          b.owner = account;
          b.asset_type = delta.asset_id;
          b.balance = delta.amount.value;
@@ -75,9 +73,10 @@ void database::adjust_balance(account_id_type account, asset delta )
       if( delta.amount < 0 )
          FC_ASSERT( abo->get_balance() >= -delta, "Insufficient Balance: ${a}'s balance of ${b} is less than required ${r}",
                     ("a",account(*this).name)("b",to_pretty_string(abo->get_balance()))("r",to_pretty_string(-delta)));
-      modify(*abo, [delta](account_balance_object& b) {
+      // balances are only indexed by id
+      modify_in< primary_index< account_balance_index > >(*abo, [delta](account_balance_object& b) {
          b.adjust_balance(delta);
-      });
+      }, true);
    }
 
 } FC_CAPTURE_AND_RETHROW( (account)(delta) ) }
@@ -43,6 +43,8 @@
 #include <fc/io/raw.hpp>
 #include <fc/thread/parallel.hpp>
 
+#include <atomic>
+
 namespace graphene { namespace chain {
 
 bool database::is_known_block( const block_id_type& id )const
@@ -152,8 +154,25 @@ bool database::_push_block(const signed_block& new_block)
       if( new_head->data.block_num() > head_block_num() )
       {
          wlog( "Switching to fork: ${id}", ("id",new_head->data.id()) );
+         const auto switch_start = fc::time_point::now();
          auto branches = _fork_db.fetch_branch_from(new_head->data.id(), head_block_id());
 
+         // Blocks of the new fork are precomputed in parallel while blocks of the current fork are popped.
+         // Each task holds its fork item, so it stays alive even if the switch fails.
+         std::vector<fc::future<void>> precomputed;
+         if( 0 == (skip & skip_transaction_signatures) || 0 == (skip & skip_witness_signature) )
+         {
+            precomputed.reserve( branches.first.size() );
+            for( auto ritr = branches.first.rbegin(); ritr != branches.first.rend(); ++ritr )
+               precomputed.push_back( fc::do_parallel( [this,item=*ritr,skip] () {
+                  const signed_block& block = item->data;
+                  if( !block.transactions.empty() )
+                     _precompute_parallel( &block.transactions[0], block.transactions.size(), skip );
+                  if( 0 == (skip & skip_witness_signature) )
+                     block.signee();
+               }) );
+         }
+
          // pop blocks until we hit the forked block
          while( head_block_id() != branches.second.back()->data.previous )
          {
@@ -167,6 +186,8 @@ bool database::_push_block(const signed_block& new_block)
                ilog( "pushing block from fork #${n} ${id}", ("n",(*ritr)->data.block_num())("id",(*ritr)->id) );
                optional<fc::exception> except;
                try {
+                  if( !precomputed.empty() )
+                     precomputed[ ritr - branches.first.rbegin() ].wait();
                   undo_database::session session = _undo_db.start_undo_session();
                   apply_block( (*ritr)->data, skip );
                   update_witnesses( **ritr );
@@ -206,9 +227,19 @@ bool database::_push_block(const signed_block& new_block)
                   throw *except;
                }
          }
+         _fork_db.prune_forks();
+         wlog( "Switched to fork ${id}: popped ${p} and pushed ${n} blocks in ${t}ms, "
+               "fork database holds ${s} blocks using ${m} bytes",
+               ("id",new_head->id)("p",branches.second.size())("n",branches.first.size())
+               ("t",(fc::time_point::now() - switch_start).count() / 1000)
+               ("s",_fork_db.size())("m",_fork_db.memory_usage()) );
          return true;
       }
-      else return false;
+      else
+      {
+         _fork_db.prune_forks();
+         return false;
+      }
    }
 
    try {
@@ -223,6 +254,7 @@ bool database::_push_block(const signed_block& new_block)
       _fork_db.remove( new_block.id() );
       throw;
    }
+   _fork_db.prune_forks();
 
    return false;
 } FC_CAPTURE_AND_RETHROW( (new_block) ) }
@@ -853,14 +885,16 @@ fc::future<void> database::precompute_parallel( const signed_block& block, const
          _precompute_parallel( &block.transactions[0], block.transactions.size(), skip );
       else
       {
-         uint32_t chunks = fc::asio::default_io_service_scope::get_num_threads();
-         uint32_t chunk_size = ( block.transactions.size() + chunks - 1 ) / chunks;
-         workers.reserve( chunks + 1 );
-         for( size_t base = 0; base < block.transactions.size(); base += chunk_size )
-            workers.push_back( fc::do_parallel( [this,&block,base,chunk_size,skip] () {
-               _precompute_parallel( &block.transactions[base],
-                                     base + chunk_size < block.transactions.size() ? chunk_size : block.transactions.size() - base,
-                                     skip );
+         // Transactions differ a lot in cost, mostly with their number of signatures, so instead of splitting
+         // the block into fixed chunks the workers take the next transaction from a shared cursor until none is left.
+         const size_t count = block.transactions.size();
+         const size_t threads = std::min<size_t>( fc::asio::default_io_service_scope::get_num_threads(), count );
+         auto next = std::make_shared<std::atomic<size_t>>( 0 );
+         workers.reserve( threads + 1 );
+         for( size_t t = 0; t < threads; ++t )
+            workers.push_back( fc::do_parallel( [this,&block,next,count,skip] () {
+               for( size_t i = (*next)++; i < count; i = (*next)++ )
+                  _precompute_parallel( &block.transactions[i], 1, skip );
             }) );
       }
    }
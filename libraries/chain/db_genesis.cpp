@@ -39,7 +39,9 @@
 #include <graphene/chain/witness_schedule_object.hpp>
 #include <graphene/chain/worker_object.hpp>
 
+#include <fc/asio.hpp>
 #include <fc/crypto/digest.hpp>
+#include <fc/thread/parallel.hpp>
 
 #include <boost/algorithm/string.hpp>
 
@@ -393,37 +395,109 @@ void database::init_genesis(const genesis_state_type& genesis_state)
       });
    }
 
-   // Create initial balances
-   share_type total_allocation;
-   for( const auto& handout : genesis_state.initial_balances )
+   // Create initial balances and vesting balances.
+   // There can be millions of them, and each one depends only on the genesis record and the asset, so the objects
+   // are built in parallel chunks, then inserted in genesis order with the ids that creating them one by one
+   // would have assigned.
+   if( _parallel_genesis )
    {
-      const auto asset_id = get_asset_id(handout.asset_symbol);
-      create<balance_object>([&handout,total_allocation,asset_id](balance_object& b) {
-         b.balance = asset(handout.amount, asset_id);
-         b.owner = handout.owner;
-      });
+      const auto& handouts = genesis_state.initial_balances;
+      const auto& vestings = genesis_state.initial_vesting_balances;
+      const size_t count = handouts.size() + vestings.size();
+      index& balances = get_mutable_index<balance_object>();
+      const uint64_t first_instance = balances.get_next_id().instance();
+
+      vector<balance_object> new_balances( count );
+      const size_t min_chunk_size = 1000;
+      const size_t chunks = std::max<size_t>( 1, std::min<size_t>( fc::asio::default_io_service_scope::get_num_threads(),
+                                                                   count / min_chunk_size ) );
+      const size_t chunk_size = ( count + chunks - 1 ) / chunks;
+      vector< map<asset_id_type, share_type> > chunk_supplies( chunks );
+      vector< fc::future<void> > tasks;
+      tasks.reserve( chunks );
+      for( size_t chunk = 0; chunk < chunks; ++chunk )
+         tasks.push_back( fc::do_parallel( [&,chunk]() {
+            const size_t end = std::min( count, ( chunk + 1 ) * chunk_size );
+            for( size_t i = chunk * chunk_size; i < end; ++i )
+            {
+               balance_object& b = new_balances[i];
+               b.id = object_id_type( balance_object::space_id, balance_object::type_id, first_instance + i );
+               if( i < handouts.size() )
+               {
+                  const auto& handout = handouts[i];
+                  const auto asset_id = get_asset_id(handout.asset_symbol);
+                  b.balance = asset(handout.amount, asset_id);
+                  b.owner = handout.owner;
+                  chunk_supplies[chunk][ asset_id ] += handout.amount;
+               }
+               else
+               {
+                  const auto& vest = vestings[ i - handouts.size() ];
+                  const auto asset_id = get_asset_id(vest.asset_symbol);
+                  b.owner = vest.owner;
+                  b.balance = asset(vest.amount, asset_id);
+
+                  linear_vesting_policy policy;
+                  policy.begin_timestamp = vest.begin_timestamp;
+                  policy.vesting_cliff_seconds = 0;
+                  policy.vesting_duration_seconds = vest.vesting_duration_seconds;
+                  policy.begin_balance = vest.begin_balance;
+
+                  b.vesting_policy = std::move(policy);
+                  chunk_supplies[chunk][ asset_id ] += vest.amount;
+               }
+            }
+         }) );
+      // wait for every task before reporting a failure, they refer to local data
+      std::exception_ptr failure;
+      for( auto& task : tasks )
+      {
+         try { task.wait(); } catch( ... ) { if( !failure ) failure = std::current_exception(); }
+      }
+      if( failure )
+         std::rethrow_exception( failure );
 
-      total_supplies[ asset_id ] += handout.amount;
-   }
+      for( const auto& supplies : chunk_supplies )
+         for( const auto& item : supplies )
+            total_supplies[ item.first ] += item.second;
 
-   // Create initial vesting balances
-   for( const genesis_state_type::initial_vesting_balance_type& vest : genesis_state.initial_vesting_balances )
+      for( auto& b : new_balances )
+      {
+         balances.insert( std::move(b) );
+         balances.use_next_id();
+      }
+   }
+   else
    {
-      const auto asset_id = get_asset_id(vest.asset_symbol);
-      create<balance_object>([&vest,&asset_id](balance_object& b) {
-         b.owner = vest.owner;
-         b.balance = asset(vest.amount, asset_id);
-
-         linear_vesting_policy policy;
-         policy.begin_timestamp = vest.begin_timestamp;
-         policy.vesting_cliff_seconds = 0;
-         policy.vesting_duration_seconds = vest.vesting_duration_seconds;
-         policy.begin_balance = vest.begin_balance;
-
-         b.vesting_policy = std::move(policy);
-      });
+      for( const auto& handout : genesis_state.initial_balances )
+      {
+         const auto asset_id = get_asset_id(handout.asset_symbol);
+         create<balance_object>([&handout,asset_id](balance_object& b) {
+            b.balance = asset(handout.amount, asset_id);
+            b.owner = handout.owner;
+         });
+
+         total_supplies[ asset_id ] += handout.amount;
+      }
 
-      total_supplies[ asset_id ] += vest.amount;
+      for( const genesis_state_type::initial_vesting_balance_type& vest : genesis_state.initial_vesting_balances )
+      {
+         const auto asset_id = get_asset_id(vest.asset_symbol);
+         create<balance_object>([&vest,&asset_id](balance_object& b) {
+            b.owner = vest.owner;
+            b.balance = asset(vest.amount, asset_id);
+
+            linear_vesting_policy policy;
+            policy.begin_timestamp = vest.begin_timestamp;
+            policy.vesting_cliff_seconds = 0;
+            policy.vesting_duration_seconds = vest.vesting_duration_seconds;
+            policy.begin_balance = vest.begin_balance;
+
+            b.vesting_policy = std::move(policy);
+         });
+
+         total_supplies[ asset_id ] += vest.amount;
+      }
    }
 
    if( total_supplies[ asset_id_type(0) ] > 0 )
@@ -163,7 +163,7 @@ void database::initialize_indexes()
    add_index< primary_index<call_order_index > >();
    add_index< primary_index<proposal_index > >();
    add_index< primary_index<withdraw_permission_index > >();
-   add_index< primary_index<vesting_balance_index> >();
+   add_index< primary_index<vesting_balance_index, 16> >(); // 65536 vesting balances per chunk
    add_index< primary_index<worker_index> >();
    add_index< primary_index<balance_index> >();
    add_index< primary_index<blinded_balance_index> >();
@@ -180,6 +180,9 @@ void database::initialize_indexes()
 
    auto bal_idx = add_index< primary_index<account_balance_index          > >();
    bal_idx->add_secondary_index<balances_by_account_index>();
+   bal_idx->add_secondary_index<balances_by_asset_index>();
+   _flagged_balances = bal_idx->add_secondary_index<flagged_balances_index>();
+   _balances_by_account = bal_idx->get_secondary_index_handle<balances_by_account_index>();
 
    add_index< primary_index<asset_bitasset_data_index,                 13 > >(); // 8192
    add_index< primary_index<simple_index<global_property_object          >> >();
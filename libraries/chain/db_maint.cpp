@@ -77,25 +77,22 @@ vector<std::reference_wrapper<const typename Index::object_type>> database::sort
 template<class Type>
 void database::perform_account_maintenance(Type tally_helper)
 {
-   const auto& bal_idx = get_index_type< account_balance_index >().indices().get< by_maintenance_flag >();
-   if( bal_idx.begin() != bal_idx.end() )
+   // The list is cleared only once every flag is, so that it is intact if the block fails and is undone
+   for( const uint64_t instance : _flagged_balances->get_flagged_balances() )
    {
-      auto bal_itr = bal_idx.rbegin();
-      while( bal_itr->maintenance_flag )
-      {
-         const account_balance_object& bal_obj = *bal_itr;
-
-         modify( get_account_stats_by_owner( bal_obj.owner ), [&bal_obj](account_statistics_object& aso) {
-            aso.core_in_balance = bal_obj.balance;
-         });
+      const account_balance_object* bal_obj = find( account_balance_id_type( instance ) );
+      if( bal_obj == nullptr || !bal_obj->maintenance_flag )
+         continue;
 
-         modify( bal_obj, []( account_balance_object& abo ) {
-            abo.maintenance_flag = false;
-         });
+      modify( get_account_stats_by_owner( bal_obj->owner ), [bal_obj](account_statistics_object& aso) {
+         aso.core_in_balance = bal_obj->balance;
+      });
 
-         bal_itr = bal_idx.rbegin();
-      }
+      modify_in< primary_index< account_balance_index > >( *bal_obj, []( account_balance_object& abo ) {
+         abo.maintenance_flag = false;
+      }, true );
    }
+   _flagged_balances->clear();
 
    const auto& stats_idx = get_index_type< account_stats_index >().indices().get< by_maintenance_seq >();
    auto stats_itr = stats_idx.lower_bound( true );
@@ -593,14 +590,15 @@ void update_top_n_authorities( database& db )
 
          const top_holders_special_authority& tha = auth.get< top_holders_special_authority >();
          vote_counter vc;
-         const auto& bal_idx = db.get_index_type< account_balance_index >().indices().get< by_asset_balance >();
+         const auto& bal_idx = db.get_index_type< primary_index< account_balance_index > >()
+                                 .get_secondary_index< balances_by_asset_index >().get_balances_by_asset();
          uint8_t num_needed = tha.num_top_holders;
          if( 0 == num_needed )
             return;
 
          // find accounts
          const auto range = bal_idx.equal_range( boost::make_tuple( tha.asset ) );
-         for( const account_balance_object& bal : boost::make_iterator_range( range.first, range.second ) )
+         for( const asset_balance_entry& bal : boost::make_iterator_range( range.first, range.second ) )
          {
              assert( bal.asset_type == tha.asset );
              if( bal.owner == acct.id )
@@ -717,8 +715,7 @@ void distribute_fba_balances( database& db )
 void create_buyback_orders( database& db )
 {
    const auto& bbo_idx = db.get_index_type< buyback_index >().indices().get<by_id>();
-   const auto& bal_idx = db.get_index_type< primary_index< account_balance_index > >()
-                           .get_secondary_index< balances_by_account_index >();
+   const auto& bal_idx = db.get_balances_by_account_index();
 
    for( const buyback_object& bbo : bbo_idx )
    {
@@ -1557,11 +1557,12 @@ bool database::fill_limit_order( const limit_order_object& order, const asset& p
    }
    else
    {
-      modify( order, [&pays]( limit_order_object& b ) {
+      // None of the changed fields is a key of the limit order index
+      modify_in< primary_index< limit_order_index > >( order, [&pays]( limit_order_object& b ) {
                              b.for_sale -= pays.amount;
                              b.deferred_fee = 0;
                              b.deferred_paid_fee.amount = 0;
-                          });
+                          }, true );
       if( cull_if_small )
          return maybe_cull_small_order( *this, order );
       return false;
@@ -1724,6 +1725,41 @@ bool database::fill_settle_order( const force_settlement_object& settle, const a
 
 } FC_CAPTURE_AND_RETHROW( (pays)(receives) ) }
 
+bool database::call_orders_may_be_triggered( const asset_bitasset_data_object& bitasset )const
+{
+   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
+   if( maint_time <= HARDFORK_CORE_1270_TIME ) // call price caching issue
+      return true;
+   if( bitasset.is_prediction_market || bitasset.has_settlement() )
+      return true;
+   if( bitasset.current_feed.settlement_price.is_null() ) // check_call_orders() does nothing without a feed
+      return false;
+
+   const call_order_object* call_ptr = find_least_collateralized_short( bitasset, true );
+   if( !call_ptr ) // no call order
+      return false;
+
+   // Margin call, see `feed_protected` in check_call_orders()
+   auto least_collateral = call_ptr->collateralization();
+   if( !( bitasset.current_maintenance_collateralization < least_collateral ) )
+      return true;
+
+   // Black swan, see check_for_blackswan().
+   // The `highest` price there is never below the lower one of the MSSPs of the feeds it uses, whatever the
+   // limit orders are, so if the least collateralized call order passes with it, it passes in check_for_blackswan()
+   using bsrm_type = bitasset_options::black_swan_response_type;
+   price lowest_highest = bitasset.current_feed.max_short_squeeze_price();
+   if( bsrm_type::individual_settlement_to_fund == bitasset.get_black_swan_response_method() )
+   {
+      if( bitasset.median_feed.settlement_price.is_null() )
+         return true;
+      lowest_highest = std::min( lowest_highest, bitasset.median_feed.max_short_squeeze_price() );
+   }
+   bool may_be_blackswan = HARDFORK_CORE_2481_PASSED( maint_time ) ? ( ~least_collateral > lowest_highest )
+                                                                   : ( ~least_collateral >= lowest_highest );
+   return may_be_blackswan;
+}
+
 /**
  *  Starting with the least collateralized orders, fill them if their
  *  call price is above the max(lowest bid,call_limit).
@@ -1763,6 +1799,10 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
     if ( maint_time >= HARDFORK_CORE_460_TIME && bitasset.is_prediction_market )
        return false;
 
+    // Most of the time the feed protects every call order, skip the order books then
+    if( !call_orders_may_be_triggered( bitasset ) )
+       return false;
+
     using bsrm_type = bitasset_options::black_swan_response_type;
     const auto bsrm = bitasset.get_black_swan_response_method();
 
@@ -403,7 +403,7 @@ void transaction_get_impacted_accs( const transaction& tx, flat_set<account_id_t
     operation_get_impacted_accounts( op, result, ignore_custom_op_required_auths );
 }
 
-static void get_relevant_accounts( const object* obj, flat_set<account_id_type>& accounts,
+void get_relevant_accounts( const object* obj, flat_set<account_id_type>& accounts,
                             bool ignore_custom_op_required_auths ) {
    FC_ASSERT( obj != nullptr, "Internal error: get_relevant_accounts called with nullptr" ); // This should not happen
    if( obj->id.space() == protocol_ids )
@@ -584,6 +584,36 @@ void database::notify_changed_objects()
       const auto& head_undo = _undo_db.head();
       auto chain_time = head_block_time();
 
+      // Deferred, only copy the objects here
+      if( deferred_object_changes.has_subscribers() )
+      {
+         auto changes = std::make_shared<object_change_set>();
+         changes->chain_time = chain_time;
+         changes->block_num = head_block_num();
+         changes->new_objects.reserve( head_undo.new_ids.size() );
+         for( const auto& item : head_undo.new_ids )
+         {
+            const auto* obj = find_object( item );
+            if( obj != nullptr )
+               changes->new_objects.emplace_back( obj->clone() );
+         }
+         changes->changed_objects.reserve( head_undo.old_values.size() );
+         changes->previous_values.reserve( head_undo.old_values.size() );
+         for( const auto& item : head_undo.old_values )
+         {
+            const auto* obj = find_object( item.first );
+            if( obj != nullptr )
+            {
+               changes->changed_objects.emplace_back( obj->clone() );
+               changes->previous_values.emplace_back( item.second->clone() );
+            }
+         }
+         changes->removed_objects.reserve( head_undo.removed.size() );
+         for( const auto& item : head_undo.removed )
+            changes->removed_objects.emplace_back( item.second->clone() );
+         deferred_object_changes.post( changes );
+      }
+
       // New
       if( !new_objects.empty() )
       {
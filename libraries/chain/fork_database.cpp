@@ -24,6 +24,8 @@
 #include <graphene/chain/fork_database.hpp>
 #include <graphene/chain/exceptions.hpp>
 
+#include <unordered_set>
+
 namespace graphene { namespace chain {
 fork_database::fork_database()
 {
@@ -32,6 +34,7 @@ void fork_database::reset()
 {
    _head.reset();
    _index.clear();
+   _memory_usage = 0;
 }
 
 void fork_database::pop_block()
@@ -45,7 +48,8 @@ void fork_database::pop_block()
 void     fork_database::start_block(signed_block b)
 {
    auto item = std::make_shared<fork_item>(std::move(b));
-   _index.insert(item);
+   if( _index.insert(item).second )
+      _memory_usage += item->packed_size;
    _head = item;
 }
 
@@ -85,7 +89,8 @@ void  fork_database::_push_block(const item_ptr& item)
       item->prev = *itr;
    }
 
-   _index.insert(item);
+   if( _index.insert(item).second )
+      _memory_usage += item->packed_size;
    if( !_head ) _head = item;
    else if( item->num > _head->num )
    {
@@ -93,7 +98,10 @@ void  fork_database::_push_block(const item_ptr& item)
       uint32_t min_num = _head->num - std::min( _max_size, _head->num );
       auto& num_idx = _index.get<block_num>();
       while( !num_idx.empty() && (*num_idx.begin())->num < min_num )
+      {
+         _memory_usage -= (*num_idx.begin())->packed_size;
          num_idx.erase( num_idx.begin() );
+      }
    }
 }
 
@@ -107,7 +115,10 @@ void fork_database::set_max_size( uint32_t s )
    while( itr != by_num_idx.end() )
    {
       if( (*itr)->num < std::max(int64_t(0),int64_t(_head->num) - _max_size) )
+      {
+         _memory_usage -= (*itr)->packed_size;
          by_num_idx.erase(itr);
+      }
       else
          break;
       itr = by_num_idx.begin();
@@ -194,9 +205,77 @@ void fork_database::set_head(shared_ptr<fork_item> h)
    _head = h;
 }
 
+void fork_database::prune_forks()
+{
+   // The running total is enough to tell that there is nothing to do, which is the usual case
+   if( !_head || 0 == _max_memory || _memory_usage <= _max_memory )
+      return;
+
+   typedef std::unordered_set<block_id_type, std::hash<fc::ripemd160>> id_set;
+   auto& num_idx = _index.get<block_num>();
+
+   // Forks can only be switched to from a common ancestor that is still known
+   item_ptr root = _head;
+   for( item_ptr prev = root->prev.lock(); prev && is_known_block( prev->id ); prev = prev->prev.lock() )
+      root = prev;
+
+   // Parents are visited before their children, so one pass in order of block number finds all descendants
+   id_set live;
+   for( auto itr = num_idx.begin(); itr != num_idx.end(); )
+   {
+      const item_ptr& item = *itr;
+      if( item == root || ( item->num > root->num && live.find( item->previous_id() ) != live.end() ) )
+      {
+         live.insert( item->id );
+         ++itr;
+      }
+      else
+      {
+         ++_pruned_blocks;
+         _memory_usage -= item->packed_size;
+         itr = num_idx.erase( itr );
+      }
+   }
+
+   if( _memory_usage <= _max_memory )
+      return;
+
+   // Blocks on the branch of head are needed to pop blocks, drop those of other forks, oldest first
+   id_set head_branch;
+   for( item_ptr item = _head; item && item != root; item = item->prev.lock() )
+      head_branch.insert( item->id );
+   head_branch.insert( root->id );
+
+   id_set dropped;
+   for( auto itr = num_idx.begin(); itr != num_idx.end(); )
+   {
+      const item_ptr& item = *itr;
+      // Descendants of a dropped block could no longer be linked, so they are dropped too
+      if( dropped.find( item->previous_id() ) != dropped.end()
+            || ( _memory_usage > _max_memory && head_branch.find( item->id ) == head_branch.end() ) )
+      {
+         dropped.insert( item->id );
+         ++_pruned_blocks;
+         _memory_usage -= item->packed_size;
+         itr = num_idx.erase( itr );
+      }
+      else
+         ++itr;
+   }
+   if( !dropped.empty() )
+      wlog( "Dropped ${n} blocks of other forks from fork database, ${s} blocks using ${m} bytes remain",
+            ("n",dropped.size())("s",_index.size())("m",_memory_usage) );
+}
+
 void fork_database::remove(block_id_type id)
 {
-   _index.get<block_id>().erase(id);
+   auto& index = _index.get<block_id>();
+   auto itr = index.find(id);
+   if( itr != index.end() )
+   {
+      _memory_usage -= (*itr)->packed_size;
+      index.erase(itr);
+   }
    // If we're removing head, try to pop it
    if( _head && _head->id == id )
    {
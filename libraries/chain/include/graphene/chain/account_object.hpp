@@ -28,6 +28,9 @@
 #include <graphene/protocol/account.hpp>
 
 #include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/ranked_index.hpp>
+
+#include <unordered_map>
 
 namespace graphene { namespace chain {
    class database;
@@ -380,23 +383,31 @@ namespace graphene { namespace chain {
          std::stack< object_id_type > ids_being_modified;
    };
 
+   /// The part of an account balance by which @ref balances_by_asset_index orders balances
+   struct asset_balance_entry
+   {
+      asset_id_type   asset_type;
+      share_type      balance;
+      account_id_type owner;
+
+      bool operator==( const asset_balance_entry& o )const
+      { return asset_type == o.asset_type && balance == o.balance && owner == o.owner; }
+   };
+
    struct by_asset_balance;
-   struct by_maintenance_flag;
    /**
-    * @ingroup object_index
+    * @note @ref by_asset_balance is a ranked index, so that the number of holders of an asset and the holder at a
+    *       given position are found in logarithmic time
     */
    typedef multi_index_container<
-      account_balance_object,
+      asset_balance_entry,
       indexed_by<
-         ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >,
-         ordered_non_unique< tag<by_maintenance_flag>,
-                             member< account_balance_object, bool, &account_balance_object::maintenance_flag > >,
-         ordered_unique< tag<by_asset_balance>,
+         ranked_unique< tag<by_asset_balance>,
             composite_key<
-               account_balance_object,
-               member<account_balance_object, asset_id_type, &account_balance_object::asset_type>,
-               member<account_balance_object, share_type, &account_balance_object::balance>,
-               member<account_balance_object, account_id_type, &account_balance_object::owner>
+               asset_balance_entry,
+               member<asset_balance_entry, asset_id_type, &asset_balance_entry::asset_type>,
+               member<asset_balance_entry, share_type, &asset_balance_entry::balance>,
+               member<asset_balance_entry, account_id_type, &asset_balance_entry::owner>
             >,
             composite_key_compare<
                std::less< asset_id_type >,
@@ -405,6 +416,78 @@ namespace graphene { namespace chain {
             >
          >
       >
+   > asset_balance_multi_index_type;
+
+   /**
+    *  @brief This secondary index orders the balances of each asset by amount.
+    *
+    *  Balance changes are only recorded when they happen, and applied to the ordering in a batch when it is next
+    *  requested, so that transfers do not pay for keeping a tree sorted by amount. Repeated changes of a balance
+    *  between two requests are applied once.
+    */
+   class balances_by_asset_index : public secondary_index
+   {
+      public:
+         virtual void object_inserted( const object& obj ) override;
+         virtual void object_removed( const object& obj ) override;
+         virtual void about_to_modify( const object& before ) override;
+         virtual void object_modified( const object& after  ) override;
+
+         /** @return balances ordered by asset, then by decreasing amount, then by owner */
+         const asset_balance_multi_index_type::index<by_asset_balance>::type& get_balances_by_asset()const;
+
+      private:
+         struct pending_change
+         {
+            /** The entry of the balance in @ref ordered, if any */
+            optional< asset_balance_entry > old_entry;
+            /** The entry the balance should have, none if it was removed */
+            optional< asset_balance_entry > new_entry;
+         };
+
+         static asset_balance_entry make_entry( const object& obj );
+         void apply_pending_changes()const;
+
+         mutable asset_balance_multi_index_type                  ordered;
+         /** Changes not yet applied to @ref ordered, by balance object instance */
+         mutable std::unordered_map< uint64_t, pending_change >  pending_changes;
+   };
+
+   /**
+    *  @brief This secondary index lists the balance objects whose @ref account_balance_object::maintenance_flag
+    *         has been set since the list was last cleared, so that they are found at the maintenance interval
+    *         without keeping an index ordered by the flag.
+    */
+   class flagged_balances_index : public secondary_index
+   {
+      public:
+         virtual void object_inserted( const object& obj ) override;
+         virtual void object_modified( const object& after  ) override;
+
+         /**
+          * @return the instances of the listed balance objects in ascending order. The objects may have been removed
+          *         or their flag cleared since they were listed.
+          */
+         const vector< uint64_t >& get_flagged_balances();
+         void clear();
+
+      private:
+         void add( const object& obj );
+
+         vector< uint64_t > flagged;
+         /** Whether each balance object instance is in @ref flagged */
+         vector< bool >     is_flagged;
+         bool               sorted = true;
+   };
+
+   /**
+    * @ingroup object_index
+    */
+   typedef multi_index_container<
+      account_balance_object,
+      indexed_by<
+         ordered_unique< tag<by_id>, member< object, object_id_type, &object::id > >
+      >
    > account_balance_object_multi_index_type;
 
    /**
@@ -33,6 +33,7 @@
 #include <graphene/chain/block_database.hpp>
 #include <graphene/chain/genesis_state.hpp>
 #include <graphene/chain/evaluator.hpp>
+#include <graphene/chain/object_change_notifier.hpp>
 
 #include <graphene/db/object_database.hpp>
 #include <graphene/db/object.hpp>
@@ -259,6 +260,9 @@ namespace graphene { namespace chain {
           */
          void adjust_balance(account_id_type account, asset delta);
 
+         /// The index of account balances by account, which @ref get_balance and @ref adjust_balance use
+         const balances_by_account_index& get_balances_by_account_index()const { return *_balances_by_account; }
+
          void deposit_market_fee_vesting_balance(const account_id_type &account_id, const asset &delta);
          /**
           * @brief Retrieve a particular account's market fee vesting balance in a given asset
@@ -392,6 +396,19 @@ namespace graphene { namespace chain {
                                  bool mute_exceptions = false,
                                  bool skip_matching_settle_orders = false );
 
+         /**
+          * @brief Check cheaply whether @ref check_call_orders may change anything in a market
+          * @param bitasset The bitasset data object of the debt asset
+          * @return false if the current feed protects every call order of the asset, i.e. the least collateralized
+          *         call order is above the maintenance collateralization and can not be black swanned by any limit
+          *         order, true otherwise
+          *
+          * Only the call order with the least collateral ratio and the feed are looked at, the order books are not.
+          * Since the core-1270 hard fork this is a sufficient condition for @ref check_call_orders to be a no-op;
+          * before it, this function always returns true.
+          */
+         bool call_orders_may_be_triggered( const asset_bitasset_data_object& bitasset )const;
+
          /**
           * Matches the two orders, the first parameter is taker, the second is maker.
           *
@@ -626,6 +643,13 @@ namespace graphene { namespace chain {
          fc::signal<void(const vector<object_id_type>&,
                          const vector<const object*>&, const flat_set<account_id_type>&)>  removed_objects;
 
+         /**
+          *  Receives copies of the objects that are reported by @ref new_objects, @ref changed_objects and
+          *  @ref removed_objects, but delivers them on a separate thread, so that slow subscribers do not
+          *  delay block application.
+          */
+         object_change_notifier deferred_object_changes;
+
          ///@{
          /**
           *  This method validates transactions without adding it to the pending state.
@@ -673,6 +697,8 @@ namespace graphene { namespace chain {
       private:
          optional<undo_database::session>       _pending_tx_session;
          vector< unique_ptr<op_evaluator> >     _operation_evaluators;
+         secondary_index_handle<balances_by_account_index> _balances_by_account;
+         flagged_balances_index*                _flagged_balances = nullptr;
 
          template<class Index>
          vector<std::reference_wrapper<const typename Index::object_type>> sort_votable_objects(size_t count)const;
@@ -787,6 +813,9 @@ namespace graphene { namespace chain {
          /// Set it to true to provide accurate data to API clients, set to false to have better performance.
          bool                              _track_standby_votes = true;
 
+         /// Whether to build the initial balances of the genesis state in parallel, or one by one
+         bool                              _parallel_genesis = true;
+
          /**
           * Whether database is successfully opened or not.
           *
@@ -814,6 +843,12 @@ namespace graphene { namespace chain {
       public:
          /// Enable or disable tracking of votes of standby witnesses and committee members
          inline void enable_standby_votes_tracking(bool enable)  { _track_standby_votes = enable; }
+         /// Enable or disable building the initial balances of the genesis state in parallel
+         inline void enable_parallel_genesis(bool enable)  { _parallel_genesis = enable; }
+         /// Set the approximate limit of memory used by blocks in the fork database, 0 for no limit
+         inline void set_fork_db_max_memory(uint64_t bytes)  { _fork_db.set_max_memory( bytes ); }
+         /// The fork database, to report its size and memory usage
+         inline const fork_database& get_fork_db()const  { return _fork_db; }
    };
 
 } }
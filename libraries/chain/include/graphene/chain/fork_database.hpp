@@ -27,6 +27,8 @@
 
 #include <graphene/chain/types.hpp>
 
+#include <fc/io/raw.hpp>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -40,7 +42,7 @@ namespace graphene { namespace chain {
    struct fork_item
    {
       fork_item( signed_block d )
-      :num(d.block_num()),id(d.id()),data( std::move(d) ){}
+      :num(d.block_num()),id(d.id()),data( std::move(d) ),packed_size( fc::raw::pack_size( data ) ){}
 
       block_id_type previous_id()const { return data.previous; }
 
@@ -48,6 +50,7 @@ namespace graphene { namespace chain {
       uint32_t              num;    // initialized in ctor
       block_id_type         id;
       signed_block          data;
+      uint64_t              packed_size; // initialized in ctor, used to account memory usage
 
       // contains witness block signing keys scheduled *after* the block has been applied
       shared_ptr< vector< pair< witness_id_type, public_key_type > > > scheduled_witnesses;
@@ -66,6 +69,10 @@ namespace graphene { namespace chain {
     *
     *  Every time a block is pushed into the fork DB the
     *  block with the highest block_num will be returned.
+    *
+    *  Once a memory limit is exceeded, blocks of forks which can no longer
+    *  become part of the chain, then blocks of other forks, are dropped
+    *  by @ref prune_forks.
     */
    class fork_database
    {
@@ -110,12 +117,40 @@ namespace graphene { namespace chain {
 
          void set_max_size( uint32_t s );
 
+         /**
+          *  Set the approximate limit of memory used by the blocks, 0 for no limit.
+          *  The limit is enforced by @ref prune_forks.
+          */
+         void set_max_memory( uint64_t bytes ) { _max_memory = bytes; }
+
+         /**
+          *  Does nothing unless the memory limit is exceeded. Otherwise remove the blocks which are
+          *  not descendants of the oldest known ancestor of head, since they can never be switched to.
+          *  Then, if the limit is still exceeded, remove blocks which are not on the branch of head,
+          *  oldest first, along with their descendants.
+          *  Must not be called while switching forks, since the branch being switched from is not
+          *  protected.
+          */
+         void prune_forks();
+
+         /// @return the number of blocks in the fork database
+         size_t   size()const { return _index.size(); }
+         /// @return the total packed size of the blocks in the fork database, kept up to date as blocks come and go
+         uint64_t memory_usage()const { return _memory_usage; }
+         /// @return the memory limit, 0 for no limit
+         uint64_t max_memory()const { return _max_memory; }
+         /// @return the number of blocks removed by @ref prune_forks so far
+         uint64_t pruned_blocks()const { return _pruned_blocks; }
+
       private:
          /** @return a pointer to the newly pushed item */
          void _push_block(const item_ptr& b );
          void _push_next(const item_ptr& newly_inserted);
 
          uint32_t                 _max_size = 1024;
+         uint64_t                 _max_memory = 0;
+         uint64_t                 _memory_usage = 0;
+         uint64_t                 _pruned_blocks = 0;
 
          fork_multi_index_type    _index;
          shared_ptr<fork_item>    _head;
@@ -27,6 +27,7 @@
 #include <graphene/protocol/operations.hpp>
 #include <graphene/protocol/transaction.hpp>
 #include <graphene/protocol/types.hpp>
+#include <graphene/db/object.hpp>
 
 namespace graphene { namespace chain {
 
@@ -38,4 +39,9 @@ void transaction_get_impacted_accounts( const graphene::chain::transaction& tx,
                                         fc::flat_set<graphene::chain::account_id_type>& result,
                                         bool ignore_custom_operation_required_auths );
 
+/// Collects the accounts that a database object relates to
+void get_relevant_accounts( const graphene::db::object* obj,
+                            fc::flat_set<graphene::chain::account_id_type>& accounts,
+                            bool ignore_custom_operation_required_auths );
+
 } } // graphene::app
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/protocol/types.hpp>
+#include <graphene/db/object.hpp>
+
+#include <fc/reflect/reflect.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief A self-contained copy of the objects created, modified and removed by a block or a
+    *  pushed transaction.
+    *
+    *  The objects are copies, so the change set can be inspected on another thread while the
+    *  database keeps applying blocks. Impacted accounts are computed on first access.
+    */
+   class object_change_set
+   {
+      public:
+         using object_ptr = std::shared_ptr<const graphene::db::object>;
+
+         fc::time_point_sec  chain_time;
+         uint32_t            block_num = 0;
+
+         vector<object_ptr>  new_objects;
+         /// the values after the change
+         vector<object_ptr>  changed_objects;
+         /// the values before the change, in the same order as @ref changed_objects
+         vector<object_ptr>  previous_values;
+         /// the last values before removal
+         vector<object_ptr>  removed_objects;
+
+         const flat_set<account_id_type>& new_accounts_impacted()const;
+         /// Computed from @ref previous_values, as for @ref database::changed_objects
+         const flat_set<account_id_type>& changed_accounts_impacted()const;
+         const flat_set<account_id_type>& removed_accounts_impacted()const;
+
+      private:
+         void compute_impacted_accounts()const;
+
+         mutable std::once_flag             _impacted_computed;
+         mutable flat_set<account_id_type>  _new_accounts_impacted;
+         mutable flat_set<account_id_type>  _changed_accounts_impacted;
+         mutable flat_set<account_id_type>  _removed_accounts_impacted;
+   };
+
+   /// Delivery statistics of a deferred change subscriber
+   struct change_subscriber_stats
+   {
+      string            name;
+      uint32_t          max_queue_size = 0;
+      uint32_t          queue_size = 0;
+      uint64_t          delivered = 0;
+      /// number of change sets that were not delivered because the queue was full
+      uint64_t          dropped = 0;
+      /// number of deliveries that took longer than the slow consumer threshold
+      uint64_t          slow = 0;
+      fc::microseconds  max_delivery_time;
+   };
+
+   /**
+    *  @brief Fans out change sets to subscribers on a dedicated thread.
+    *
+    *  Each subscriber has its own bounded queue. When a subscriber can not keep up, new change sets
+    *  for it are dropped instead of blocking the producer, i.e. block application.
+    *  The thread is only started when the first subscriber is added.
+    */
+   class object_change_notifier
+   {
+      public:
+         using callback_type = std::function<void(const object_change_set&)>;
+
+         explicit object_change_notifier( fc::microseconds slow_threshold = fc::milliseconds(50) );
+         ~object_change_notifier();
+
+         /// @return an id to be used for @ref unsubscribe
+         uint32_t subscribe( const string& name, callback_type callback, uint32_t max_queue_size = 1000 );
+         void     unsubscribe( uint32_t subscriber_id );
+
+         bool has_subscribers()const { return _subscriber_count.load() > 0; }
+
+         /// Deliveries which take longer than @p threshold are counted as slow
+         void set_slow_threshold( fc::microseconds threshold );
+
+         /// Queues the change set for every subscriber, never blocks on subscribers
+         void post( const std::shared_ptr<const object_change_set>& changes );
+
+         /// Waits until all queued change sets are delivered or dropped
+         void flush();
+
+         vector<change_subscriber_stats> get_stats()const;
+
+      private:
+         struct subscriber
+         {
+            callback_type                                         callback;
+            std::deque< std::shared_ptr<const object_change_set> > queue;
+            change_subscriber_stats                               stats;
+            bool                                                  drain_scheduled = false;
+            bool                                                  dropping = false;
+         };
+
+         void drain( uint32_t subscriber_id );
+
+         fc::microseconds                                   _slow_threshold;
+         mutable std::mutex                                 _mutex;
+         std::map< uint32_t, std::shared_ptr<subscriber> >  _subscribers;
+         std::atomic<uint32_t>                              _subscriber_count { 0 };
+         uint32_t                                           _next_subscriber_id = 0;
+         std::unique_ptr<fc::thread>                        _thread;
+   };
+
+} } // graphene::chain
+
+FC_REFLECT( graphene::chain::change_subscriber_stats,
+            (name)(max_queue_size)(queue_size)(delivered)(dropped)(slow)(max_delivery_time) )
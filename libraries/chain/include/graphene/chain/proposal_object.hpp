@@ -55,6 +55,13 @@ class proposal_object : public abstract_object<proposal_object>
       std::string                   fail_reason;
 
       bool is_authorized_to_execute(database& db) const;
+
+      /**
+       * @return the accounts required by the proposed transaction which the available approvals cannot satisfy.
+       *         This errs on the side of satisfaction: a proposal with missing approvals is not authorized to
+       *         execute, but one without may still not be.
+       */
+      flat_set<account_id_type> get_missing_approvals( const database& db )const;
 };
 
 /**
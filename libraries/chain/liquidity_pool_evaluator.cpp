@@ -415,22 +415,23 @@ generic_exchange_operation_result liquidity_pool_exchange_evaluator::do_apply(
                       _maker_market_fee );
    d.pay_market_fees( fee_paying_account, *_pool_pays_asset, _pool_pays, false, _taker_market_fee );
 
+   // Only the balances change, which are not indexed, so the pool can be modified in place
    const auto old_virtual_value = _pool->virtual_value;
    if( op.amount_to_sell.asset_id == _pool->asset_a )
    {
-      d.modify( *_pool, [this]( liquidity_pool_object& lpo ){
+      d.modify_in< primary_index< liquidity_pool_index > >( *_pool, [this]( liquidity_pool_object& lpo ){
          lpo.balance_a += _pool_receives.amount;
          lpo.balance_b -= _pool_pays.amount;
          lpo.update_virtual_value();
-      });
+      }, true );
    }
    else
    {
-      d.modify( *_pool, [this]( liquidity_pool_object& lpo ){
+      d.modify_in< primary_index< liquidity_pool_index > >( *_pool, [this]( liquidity_pool_object& lpo ){
          lpo.balance_b += _pool_receives.amount;
          lpo.balance_a -= _pool_pays.amount;
          lpo.update_virtual_value();
-      });
+      }, true );
    }
 
    FC_ASSERT( _pool->balance_a > 0 && _pool->balance_b > 0, "Internal error" );
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/chain/object_change_notifier.hpp>
+#include <graphene/chain/hardfork.hpp>
+#include <graphene/chain/impacted.hpp>
+
+namespace graphene { namespace chain {
+
+void object_change_set::compute_impacted_accounts()const
+{
+   std::call_once( _impacted_computed, [this]() {
+      bool ignore_custom_op_reqd_auths = MUST_IGNORE_CUSTOM_OP_REQD_AUTHS( chain_time );
+      for( const auto& obj : new_objects )
+         get_relevant_accounts( obj.get(), _new_accounts_impacted, ignore_custom_op_reqd_auths );
+      for( const auto& obj : previous_values )
+         get_relevant_accounts( obj.get(), _changed_accounts_impacted, ignore_custom_op_reqd_auths );
+      for( const auto& obj : removed_objects )
+         get_relevant_accounts( obj.get(), _removed_accounts_impacted, ignore_custom_op_reqd_auths );
+   });
+}
+
+const flat_set<account_id_type>& object_change_set::new_accounts_impacted()const
+{
+   compute_impacted_accounts();
+   return _new_accounts_impacted;
+}
+
+const flat_set<account_id_type>& object_change_set::changed_accounts_impacted()const
+{
+   compute_impacted_accounts();
+   return _changed_accounts_impacted;
+}
+
+const flat_set<account_id_type>& object_change_set::removed_accounts_impacted()const
+{
+   compute_impacted_accounts();
+   return _removed_accounts_impacted;
+}
+
+object_change_notifier::object_change_notifier( fc::microseconds slow_threshold )
+   : _slow_threshold( slow_threshold )
+{
+}
+
+object_change_notifier::~object_change_notifier()
+{
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      _subscribers.clear();
+      _subscriber_count = 0;
+   }
+   if( _thread )
+      _thread->quit();
+}
+
+void object_change_notifier::set_slow_threshold( fc::microseconds threshold )
+{
+   std::lock_guard<std::mutex> guard( _mutex );
+   _slow_threshold = threshold;
+}
+
+uint32_t object_change_notifier::subscribe( const string& name, callback_type callback, uint32_t max_queue_size )
+{
+   FC_ASSERT( max_queue_size > 0, "The queue of a change subscriber can not be empty" );
+   std::lock_guard<std::mutex> guard( _mutex );
+   if( !_thread )
+      _thread = std::make_unique<fc::thread>( "change notifier" );
+   auto sub = std::make_shared<subscriber>();
+   sub->callback = std::move( callback );
+   sub->stats.name = name;
+   sub->stats.max_queue_size = max_queue_size;
+   uint32_t subscriber_id = _next_subscriber_id++;
+   _subscribers[subscriber_id] = sub;
+   _subscriber_count = _subscribers.size();
+   return subscriber_id;
+}
+
+void object_change_notifier::unsubscribe( uint32_t subscriber_id )
+{
+   std::lock_guard<std::mutex> guard( _mutex );
+   _subscribers.erase( subscriber_id );
+   _subscriber_count = _subscribers.size();
+}
+
+void object_change_notifier::post( const std::shared_ptr<const object_change_set>& changes )
+{
+   std::lock_guard<std::mutex> guard( _mutex );
+   for( auto& item : _subscribers )
+   {
+      subscriber& sub = *item.second;
+      if( sub.queue.size() >= sub.stats.max_queue_size )
+      {
+         ++sub.stats.dropped;
+         if( !sub.dropping )
+         {
+            wlog( "Change subscriber ${s} can not keep up, dropping notifications", ("s", sub.stats.name) );
+            sub.dropping = true;
+         }
+         continue;
+      }
+      sub.queue.push_back( changes );
+      if( !sub.drain_scheduled )
+      {
+         sub.drain_scheduled = true;
+         uint32_t subscriber_id = item.first;
+         _thread->async( [this,subscriber_id]() { drain( subscriber_id ); }, "change notifier drain" );
+      }
+   }
+}
+
+void object_change_notifier::drain( uint32_t subscriber_id )
+{
+   std::shared_ptr<subscriber> sub;
+   std::shared_ptr<const object_change_set> changes;
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      auto itr = _subscribers.find( subscriber_id );
+      if( itr == _subscribers.end() )
+         return;
+      sub = itr->second;
+   }
+   while( true )
+   {
+      {
+         std::lock_guard<std::mutex> guard( _mutex );
+         if( sub->queue.empty() )
+         {
+            sub->drain_scheduled = false;
+            sub->dropping = false;
+            return;
+         }
+         changes = sub->queue.front();
+         sub->queue.pop_front();
+      }
+
+      auto start = fc::time_point::now();
+      try
+      {
+         sub->callback( *changes );
+      }
+      catch( const fc::exception& e )
+      {
+         elog( "Change subscriber ${s} threw: ${e}", ("s", sub->stats.name)("e", e.to_detail_string()) );
+      }
+      catch( ... )
+      {
+         elog( "Change subscriber ${s} threw an unexpected exception", ("s", sub->stats.name) );
+      }
+      auto elapsed = fc::time_point::now() - start;
+
+      std::lock_guard<std::mutex> guard( _mutex );
+      ++sub->stats.delivered;
+      if( elapsed > _slow_threshold )
+         ++sub->stats.slow;
+      if( elapsed > sub->stats.max_delivery_time )
+         sub->stats.max_delivery_time = elapsed;
+   }
+}
+
+void object_change_notifier::flush()
+{
+   fc::thread* thread = nullptr;
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      thread = _thread.get();
+   }
+   // drain tasks run to completion one after another, so this is executed after all queued ones
+   if( thread != nullptr )
+      thread->async( [](){}, "change notifier flush" ).wait();
+}
+
+vector<change_subscriber_stats> object_change_notifier::get_stats()const
+{
+   vector<change_subscriber_stats> result;
+   std::lock_guard<std::mutex> guard( _mutex );
+   result.reserve( _subscribers.size() );
+   for( const auto& item : _subscribers )
+   {
+      result.push_back( item.second->stats );
+      result.back().queue_size = item.second->queue.size();
+   }
+   return result;
+}
+
+} } // graphene::chain
@@ -21,6 +21,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <graphene/chain/custom_authority_object.hpp>
 #include <graphene/chain/database.hpp>
 #include <graphene/chain/hardfork.hpp>
 #include <graphene/chain/transaction_evaluation_state.hpp>
@@ -31,8 +32,140 @@
 
 namespace graphene { namespace chain {
 
+namespace {
+
+/// Finds the accounts which the approvals of a proposal may approve, counting everything verify_authority could
+/// count, so that an account is left out only if verify_authority would not accept it.
+/// verify_authority remembers every account it approves and counts it again at any depth, even at the depth limit,
+/// so the approvals are computed as a fixed point over all accounts within reach instead of following the depth.
+struct approval_estimator
+{
+   const database&           db;
+   const proposal_object&    proposal;
+   const uint32_t            max_depth;
+   flat_set<account_id_type> approved;
+   flat_set<account_id_type> pending;
+
+   approval_estimator( const database& d, const proposal_object& p, uint32_t depth )
+   : db( d ), proposal( p ), max_depth( depth )
+   {
+      approved.insert( proposal.available_active_approvals.begin(), proposal.available_active_approvals.end() );
+      approved.insert( proposal.available_owner_approvals.begin(), proposal.available_owner_approvals.end() );
+      approved.insert( GRAPHENE_TEMP_ACCOUNT );
+   }
+
+   bool may_satisfy( const authority& auth )const
+   {
+      uint64_t total_weight = 0;
+      for( const auto& k : auth.key_auths )
+         if( proposal.available_key_approvals.find( k.first ) != proposal.available_key_approvals.end() )
+            total_weight += k.second;
+      // an address may be derived from any of the keys
+      if( !proposal.available_key_approvals.empty() )
+         for( const auto& a : auth.address_auths )
+            total_weight += a.second;
+      for( const auto& a : auth.account_auths )
+         if( approved.find( a.first ) != approved.end() )
+            total_weight += a.second;
+      return total_weight >= auth.weight_threshold;
+   }
+
+   /// Collects the accounts whose authorities verify_authority may check, starting from the given ones. The accounts
+   /// beyond the depth limit may still have been approved elsewhere, e.g. by a custom authority, they are counted.
+   void add_accounts( const flat_set<account_id_type>& accounts )
+   {
+      vector<account_id_type> level( accounts.begin(), accounts.end() );
+      for( uint32_t depth = 0; !level.empty(); ++depth )
+      {
+         vector<account_id_type> next;
+         for( const account_id_type id : level )
+         {
+            if( approved.find( id ) != approved.end() || pending.find( id ) != pending.end() )
+               continue;
+            if( depth > max_depth )
+            {
+               approved.insert( id );
+               continue;
+            }
+            pending.insert( id );
+            // nested owner authorities are only accepted after a hardfork, they are counted anyway
+            const account_object& acct = id( db );
+            for( const auto& a : acct.active.account_auths )
+               next.push_back( a.first );
+            for( const auto& a : acct.owner.account_auths )
+               next.push_back( a.first );
+         }
+         level = std::move( next );
+      }
+   }
+
+   void approve()
+   {
+      bool changed = true;
+      while( changed )
+      {
+         changed = false;
+         for( auto itr = pending.begin(); itr != pending.end(); )
+         {
+            const account_object& acct = (*itr)( db );
+            if( may_satisfy( acct.active ) || may_satisfy( acct.owner ) )
+            {
+               approved.insert( *itr );
+               itr = pending.erase( itr );
+               changed = true;
+            }
+            else
+               ++itr;
+         }
+      }
+   }
+};
+
+} // anonymous namespace
+
+flat_set<account_id_type> proposal_object::get_missing_approvals( const database& db )const
+{
+   flat_set<account_id_type> required_active;
+   flat_set<account_id_type> required_owner;
+   vector<authority> other;
+   for( const auto& op : proposed_transaction.operations )
+      operation_get_required_authorities( op, required_active, required_owner, other,
+                                          MUST_IGNORE_CUSTOM_OP_REQD_AUTHS( db.head_block_time() ) );
+
+   const auto& custom_auths = db.get_index_type<custom_authority_index>().indices().get<by_account_custom>();
+   // custom authorities depend on the operations, assume they may approve
+   const auto has_custom_auths = [&custom_auths]( account_id_type id ) {
+      const auto itr = custom_auths.lower_bound( boost::make_tuple( id ) );
+      return itr != custom_auths.end() && itr->account == id;
+   };
+
+   approval_estimator estimator( db, *this, db.get_global_properties().parameters.max_authority_depth );
+   estimator.add_accounts( required_owner );
+   estimator.add_accounts( required_active );
+   estimator.approve();
+
+   flat_set<account_id_type> missing;
+   for( const account_id_type id : required_owner )
+      if( estimator.approved.find( id ) == estimator.approved.end() )
+         missing.insert( id );
+   for( const account_id_type id : required_active )
+      if( estimator.approved.find( id ) == estimator.approved.end() && !has_custom_auths( id ) )
+         missing.insert( id );
+   return missing;
+}
+
 bool proposal_object::is_authorized_to_execute( database& db ) const
 {
+   // a failed verification is costly as it throws, avoid it for proposals which clearly miss approvals
+   try {
+      if( !get_missing_approvals( db ).empty() )
+         return false;
+   }
+   catch ( const fc::exception& e )
+   {
+      // leave it to the verification
+   }
+
    transaction_evaluation_state dry_run_eval( &db );
 
    try {
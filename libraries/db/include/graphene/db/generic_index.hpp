@@ -55,6 +55,12 @@ namespace graphene { namespace db {
          }
 
          virtual const object&  create(const std::function<void(object&)>& constructor )override
+         {
+            return create_object( constructor );
+         }
+
+         template<typename Constructor>
+         const ObjectType& create_object( Constructor&& constructor )
          {
             ObjectType item;
             item.id = get_next_id();
@@ -68,8 +74,24 @@ namespace graphene { namespace db {
          virtual void modify( const object& obj, const std::function<void(object&)>& m )override
          {
             assert(nullptr != dynamic_cast<const ObjectType*>(&obj));
+            modify_object( static_cast<const ObjectType&>(obj), m );
+         }
+
+         /**
+          * @param keys_unchanged whether the caller guarantees that @p m changes none of the fields the object is
+          *        indexed by, in which case the object is changed in place and its position in the indexes is not
+          *        checked again
+          */
+         template<typename Modifier>
+         void modify_object( const ObjectType& obj, Modifier&& m, bool keys_unchanged = false )
+         {
+            if( keys_unchanged )
+            {
+               m( const_cast<ObjectType&>(obj) );
+               return;
+            }
             std::exception_ptr exc;
-            auto ok = _indices.modify(_indices.iterator_to(static_cast<const ObjectType&>(obj)),
+            auto ok = _indices.modify(_indices.iterator_to(obj),
                                        [&m, &exc](ObjectType& o) mutable {
                                           try {
                                              m(o);
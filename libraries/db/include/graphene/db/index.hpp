@@ -29,6 +29,7 @@
 #include <fc/io/json.hpp>
 #include <fc/crypto/sha256.hpp>
 
+#include <array>
 #include <fstream>
 #include <stack>
 
@@ -134,6 +135,69 @@ namespace graphene { namespace db {
 
          virtual void               object_from_variant( const fc::variant& var, object& obj, uint32_t max_depth )const = 0;
          virtual void               object_default( object& obj )const = 0;
+
+         /**
+          *  Suspends the maintenance of secondary indexes, which must not be accessed until
+          *  @ref end_bulk_load is called. Objects already in the index are removed from the secondary indexes.
+          */
+         virtual void               begin_bulk_load() {}
+         /**
+          *  Resumes the maintenance of secondary indexes.
+          *  @return one task per secondary index that rebuilds it from scratch. The tasks may run in parallel,
+          *          and they must all be done before the index is used again.
+          */
+         virtual vector< std::function<void()> > end_bulk_load() { return {}; }
+
+         /**
+          *  Starts or stops maintaining a digest of the objects in this index. Starting computes it from all
+          *  objects once, after which it is updated on every change, at the cost of hashing the changed objects.
+          */
+         virtual void               enable_state_digest( bool enable ) {}
+         /** @return the digest of the objects in this index, or an empty hash if it is not maintained */
+         virtual fc::sha256         get_state_digest()const { return fc::sha256(); }
+   };
+
+   /**
+    *  An order-independent digest of a set of objects: the sum modulo 2^256 of the hashes of the objects.
+    *  Hashes can be added and subtracted in any order, so it can be updated incrementally as objects change.
+    */
+   class object_set_digest
+   {
+      public:
+         void add( const fc::sha256& h )
+         {
+            uint64_t carry = 0;
+            for( size_t i = 0; i < 4; ++i )
+            {
+               const uint64_t sum = _sum[i] + h._hash[i];
+               const uint64_t result = sum + carry;
+               carry = ( sum < _sum[i] || result < sum ) ? 1 : 0;
+               _sum[i] = result;
+            }
+         }
+         void subtract( const fc::sha256& h )
+         {
+            uint64_t borrow = 0;
+            for( size_t i = 0; i < 4; ++i )
+            {
+               const uint64_t diff = _sum[i] - h._hash[i];
+               const uint64_t result = diff - borrow;
+               borrow = ( _sum[i] < h._hash[i] || diff < borrow ) ? 1 : 0;
+               _sum[i] = result;
+            }
+         }
+         void clear() { _sum.fill( 0 ); }
+
+         fc::sha256 value()const
+         {
+            fc::sha256 result;
+            for( size_t i = 0; i < 4; ++i )
+               result._hash[i] = _sum[i];
+            return result;
+         }
+
+      private:
+         std::array<uint64_t, 4> _sum{};
    };
 
    class secondary_index
@@ -146,6 +210,8 @@ namespace graphene { namespace db {
          virtual void object_modified( const object& after  ){};
    };
 
+   template<typename T> class secondary_index_handle;
+
    /**
     *   Defines the common implementation
     */
@@ -175,6 +241,35 @@ namespace graphene { namespace db {
 
          template<typename T>
          const T& get_secondary_index()const
+         {
+            FC_ASSERT( !_bulk_loading, "Secondary indexes are not available while bulk loading" );
+            return find_secondary_index<T>();
+         }
+
+         /**
+          *  Looks up the secondary index of type T once, for code that accesses it often.
+          *  @see secondary_index_handle
+          */
+         template<typename T>
+         secondary_index_handle<T> get_secondary_index_handle()const
+         {
+            return secondary_index_handle<T>( *this, find_secondary_index<T>() );
+         }
+
+         bool is_bulk_loading()const { return _bulk_loading; }
+
+      protected:
+         vector< shared_ptr<index_observer> >   _observers;
+         vector< unique_ptr<secondary_index> >  _sindex;
+         /** while set, secondary indexes are not maintained */
+         bool                                   _bulk_loading = false;
+         /** while set, @ref _state_digest is maintained */
+         bool                                   _digest_enabled = false;
+         object_set_digest                      _state_digest;
+
+      private:
+         template<typename T>
+         const T& find_secondary_index()const
          {
             for( const auto& item : _sindex )
             {
@@ -184,12 +279,34 @@ namespace graphene { namespace db {
             FC_THROW_EXCEPTION( fc::assert_exception, "invalid index type" );
          }
 
-      protected:
-         vector< shared_ptr<index_observer> >   _observers;
-         vector< unique_ptr<secondary_index> >  _sindex;
+         object_database& _db;
+   };
+
+   /**
+    *  A reference to a secondary index of type T, obtained with base_primary_index::get_secondary_index_handle.
+    *  Accessing the index through it costs a pointer dereference instead of a search of the secondary indexes.
+    */
+   template<typename T>
+   class secondary_index_handle
+   {
+      public:
+         secondary_index_handle() = default;
+         secondary_index_handle( const base_primary_index& primary, const T& sindex )
+         : _primary( &primary ), _index( &sindex ) {}
+
+         bool valid()const { return _index != nullptr; }
+
+         const T& operator*()const
+         {
+            FC_ASSERT( _index != nullptr, "Uninitialized secondary index handle" );
+            FC_ASSERT( !_primary->is_bulk_loading(), "Secondary indexes are not available while bulk loading" );
+            return *_index;
+         }
+         const T* operator->()const { return &**this; }
 
       private:
-         object_database& _db;
+         const base_primary_index* _primary = nullptr;
+         const T*                  _index = nullptr;
    };
 
    /** @class direct_index
@@ -331,7 +448,7 @@ namespace graphene { namespace db {
          /** @return the object with id or nullptr if not found */
          virtual const object*  find( object_id_type id )const override
          {
-            if( DirectBits > 0 )
+            if( DirectBits > 0 && !_bulk_loading )
                return _direct_by_id->find( id );
             return DerivedIndex::find( id );
          }
@@ -379,17 +496,32 @@ namespace graphene { namespace db {
          virtual const object&  load( const std::vector<char>& data )override
          {
             const auto& result = DerivedIndex::insert( fc::raw::unpack<object_type>( data ) );
-            for( const auto& item : _sindex )
-               item->object_inserted( result );
+            if( !_bulk_loading )
+               for( const auto& item : _sindex )
+                  item->object_inserted( result );
+            if( _digest_enabled )
+               _state_digest.add( object_digest( result ) );
             return result;
          }
 
 
          virtual const object&  create(const std::function<void(object&)>& constructor )override
          {
-            const auto& result = DerivedIndex::create( constructor );
-            for( const auto& item : _sindex )
-               item->object_inserted( result );
+            return create_object( constructor );
+         }
+
+         /**
+          * Same as @ref create, with the constructor called directly rather than through a std::function
+          */
+         template<typename Constructor>
+         const object_type& create_object( Constructor&& constructor )
+         {
+            const auto& result = DerivedIndex::create_object( std::forward<Constructor>( constructor ) );
+            if( !_bulk_loading )
+               for( const auto& item : _sindex )
+                  item->object_inserted( result );
+            if( _digest_enabled )
+               _state_digest.add( object_digest( result ) );
             on_add( result );
             return result;
          }
@@ -397,31 +529,83 @@ namespace graphene { namespace db {
          virtual const object& insert( object&& obj ) override
          {
             const auto& result = DerivedIndex::insert( std::move( obj ) );
-            for( const auto& item : _sindex )
-               item->object_inserted( result );
+            if( !_bulk_loading )
+               for( const auto& item : _sindex )
+                  item->object_inserted( result );
+            if( _digest_enabled )
+               _state_digest.add( object_digest( result ) );
             on_add( result );
             return result;
          }
 
          virtual void  remove( const object& obj ) override
          {
-            for( const auto& item : _sindex )
-               item->object_removed( obj );
+            if( !_bulk_loading )
+               for( const auto& item : _sindex )
+                  item->object_removed( obj );
+            if( _digest_enabled )
+               _state_digest.subtract( object_digest( obj ) );
             on_remove(obj);
             DerivedIndex::remove(obj);
          }
 
          virtual void modify( const object& obj, const std::function<void(object&)>& m )override
+         {
+            modify_object( static_cast<const object_type&>( obj ), m );
+         }
+
+         /**
+          * Same as @ref modify, with @p m called directly rather than through a std::function.
+          * @param keys_unchanged whether the caller guarantees that @p m changes none of the fields the object is
+          *        indexed by in the derived index, which then does not check the position of the object again.
+          *        Secondary indexes are notified either way.
+          */
+         template<typename Modifier>
+         void modify_object( const object_type& obj, Modifier&& m, bool keys_unchanged = false )
          {
             save_undo( obj );
-            for( const auto& item : _sindex )
-               item->about_to_modify( obj );
-            DerivedIndex::modify( obj, m );
-            for( const auto& item : _sindex )
-               item->object_modified( obj );
+            if( !_bulk_loading )
+               for( const auto& item : _sindex )
+                  item->about_to_modify( obj );
+            if( _digest_enabled )
+            {
+               const object_id_type id = obj.id;
+               _state_digest.subtract( object_digest( obj ) );
+               try
+               {
+                  DerivedIndex::modify_object( obj, m, keys_unchanged );
+               }
+               catch( ... )
+               {
+                  // the object may be partly modified, or gone if it violated a uniqueness constraint
+                  const object* current = DerivedIndex::find( id );
+                  if( current != nullptr )
+                     _state_digest.add( object_digest( *current ) );
+                  throw;
+               }
+               _state_digest.add( object_digest( obj ) );
+            }
+            else
+               DerivedIndex::modify_object( obj, m, keys_unchanged );
+            if( !_bulk_loading )
+               for( const auto& item : _sindex )
+                  item->object_modified( obj );
             on_modify( obj );
          }
 
+         virtual void enable_state_digest( bool enable ) override
+         {
+            _digest_enabled = enable;
+            _state_digest.clear();
+            if( enable )
+               this->inspect_all_objects( [this]( const object& o ) { _state_digest.add( object_digest( o ) ); } );
+         }
+
+         virtual fc::sha256 get_state_digest()const override
+         {
+            return _digest_enabled ? _state_digest.value() : fc::sha256();
+         }
+
          virtual void add_observer( const shared_ptr<index_observer>& o ) override
          {
             _observers.emplace_back( o );
@@ -445,7 +629,41 @@ namespace graphene { namespace db {
             obj.id = id;
          }
 
+         virtual void begin_bulk_load() override
+         {
+            if( _bulk_loading )
+               return;
+            // empty the secondary indexes, so that end_bulk_load can rebuild them from scratch
+            this->inspect_all_objects( [this]( const object& o ) {
+               for( const auto& item : _sindex )
+                  item->object_removed( o );
+            });
+            _bulk_loading = true;
+         }
+
+         virtual vector< std::function<void()> > end_bulk_load() override
+         {
+            vector< std::function<void()> > tasks;
+            if( !_bulk_loading )
+               return tasks;
+            _bulk_loading = false;
+            tasks.reserve( _sindex.size() );
+            for( const auto& item : _sindex )
+            {
+               secondary_index* sindex = item.get();
+               tasks.emplace_back( [this,sindex]() {
+                  this->inspect_all_objects( [sindex]( const object& o ) { sindex->object_inserted( o ); } );
+               });
+            }
+            return tasks;
+         }
+
       private:
+         static fc::sha256 object_digest( const object& o )
+         {
+            return fc::sha256::hash( static_cast<const object_type&>( o ) );
+         }
+
          object_id_type                                 _next_id;
          const direct_index< object_type, DirectBits >* _direct_by_id = nullptr;
    };
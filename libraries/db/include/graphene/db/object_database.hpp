@@ -27,6 +27,7 @@
 #include <graphene/db/undo_database.hpp>
 
 #include <fc/log/logger.hpp>
+#include <fc/optional.hpp>
 
 #include <map>
 
@@ -42,7 +43,7 @@ namespace graphene { namespace db {
          object_database();
          ~object_database();
 
-         void reset_indexes() { _index.clear(); _index.resize(255); }
+         void reset_indexes() { _index.clear(); _index.resize(255); _state_digest_enabled = false; }
 
          void open(const fc::path& data_dir );
 
@@ -53,6 +54,26 @@ namespace graphene { namespace db {
          void wipe(const fc::path& data_dir); // remove from disk
          void close();
 
+         /**
+          * Suspends the maintenance of all secondary indexes, which is far cheaper than updating them for every
+          * object when lots of objects are loaded. Secondary indexes must not be accessed until
+          * @ref end_bulk_load is called.
+          */
+         void begin_bulk_load();
+         /**
+          * Rebuilds all secondary indexes in parallel and resumes their maintenance.
+          */
+         void end_bulk_load();
+
+         /**
+          * Starts or stops maintaining a digest of the whole object database, which identifies its state: two
+          * databases holding the same objects and next ids have the same digest. Starting hashes every object once,
+          * after that the digest is kept up to date at the cost of hashing each object that changes.
+          */
+         void enable_state_digest( bool enable );
+         /** @return the digest of the object database, if @ref enable_state_digest was called */
+         fc::optional<fc::sha256> get_state_digest()const;
+
          template<typename T, typename F>
          const T& create( F&& constructor )
          {
@@ -64,6 +85,16 @@ namespace graphene { namespace db {
             } ));
          }
 
+         /**
+          * Same as @ref create, for code which knows the type of the index of T: IndexType must be the type the
+          * index was added with. The constructor is inlined instead of being called through a std::function.
+          */
+         template<typename IndexType, typename F>
+         const typename IndexType::object_type& create_in( F&& constructor )
+         {
+            return get_mutable_index_type<IndexType>().create_object( std::forward<F>( constructor ) );
+         }
+
          ///These methods are used to retrieve indexes on the object_database. All public index accessors are const-access only.
          /// @{
          template<typename IndexType>
@@ -91,6 +122,17 @@ namespace graphene { namespace db {
             get_mutable_index(obj.id).modify(obj,m);
          }
 
+         /**
+          * Same as @ref modify, for code which knows the type of the index of obj: IndexType must be the type the
+          * index was added with. The modifier is inlined instead of being called through a std::function.
+          * @param keys_unchanged whether the caller guarantees that @p m changes none of the fields the object is
+          *        ordered by in the index, so that the orderings need not be checked again
+          */
+         template<typename IndexType, typename Lambda>
+         void modify_in( const typename IndexType::object_type& obj, const Lambda& m, bool keys_unchanged = false ) {
+            get_mutable_index_type<IndexType>().modify_object( obj, m, keys_unchanged );
+         }
+
          ///@}
 
          template<typename T>
@@ -176,6 +218,7 @@ namespace graphene { namespace db {
 
          fc::path                                                  _data_dir;
          vector< vector< unique_ptr<index> > >                     _index;
+         bool                                                      _state_digest_enabled = false;
    };
 
 } } // graphene::db
@@ -41,6 +41,12 @@ namespace graphene { namespace db {
          typedef T object_type;
 
          virtual const object&  create( const std::function<void(object&)>& constructor ) override
+         {
+            return create_object( constructor );
+         }
+
+         template<typename Constructor>
+         const T& create_object( Constructor&& constructor )
          {
              auto id = get_next_id();
              auto instance = id.instance();
@@ -54,6 +60,13 @@ namespace graphene { namespace db {
          }
 
          virtual void modify( const object& obj, const std::function<void(object&)>& modify_callback ) override
+         {
+            modify_object( static_cast<const T&>(obj), modify_callback );
+         }
+
+         /// Objects are only indexed by id, so @p keys_unchanged makes no difference
+         template<typename Modifier>
+         void modify_object( const T& obj, Modifier&& modify_callback, bool keys_unchanged = false )
          {
             assert( obj.id.instance() < _objects.size() );
             modify_callback( *_objects[obj.id.instance()] );
@@ -148,20 +148,87 @@ void object_database::open(const fc::path& data_dir)
    };
 
    ilog("Opening object database from ${d} ...", ("d", data_dir));
-   const auto spaces = _index.size();
-   for( size_t space = 0; space < spaces; ++space )
+   begin_bulk_load();
+   try
    {
-      const auto types = _index[space].size();
-      for( size_t type = 0; type  < types; ++type )
-         push_task( space, type );
+      const auto spaces = _index.size();
+      for( size_t space = 0; space < spaces; ++space )
+      {
+         const auto types = _index[space].size();
+         for( size_t type = 0; type  < types; ++type )
+            push_task( space, type );
+      }
+      for( auto& task : tasks )
+         task.wait();
    }
-   for( auto& task : tasks )
-      task.wait();
+   catch( ... )
+   {
+      // let the remaining loaders finish before rebuilding
+      for( auto& task : tasks )
+      {
+         try { task.wait(); } catch( ... ) {}
+      }
+      end_bulk_load();
+      throw;
+   }
+   end_bulk_load();
    ilog( "Done opening object database." );
 
 } FC_CAPTURE_AND_RETHROW( (data_dir) ) }
 
 
+void object_database::begin_bulk_load()
+{
+   for( auto& space : _index )
+      for( auto& idx : space )
+         if( idx )
+            idx->begin_bulk_load();
+}
+
+void object_database::end_bulk_load()
+{ try {
+   std::vector<fc::future<void>> tasks;
+   tasks.reserve(200);
+   for( auto& space : _index )
+      for( auto& idx : space )
+         if( idx )
+            for( auto& rebuild : idx->end_bulk_load() )
+               tasks.push_back( fc::do_parallel( std::move( rebuild ) ) );
+   for( auto& task : tasks )
+      task.wait();
+} FC_CAPTURE_AND_RETHROW() }
+
+void object_database::enable_state_digest( bool enable )
+{ try {
+   std::vector<fc::future<void>> tasks;
+   tasks.reserve(200);
+   for( auto& space : _index )
+      for( auto& idx : space )
+         if( idx )
+         {
+            index* i = idx.get();
+            tasks.push_back( fc::do_parallel( [i,enable]() { i->enable_state_digest( enable ); } ) );
+         }
+   for( auto& task : tasks )
+      task.wait();
+   _state_digest_enabled = enable;
+} FC_CAPTURE_AND_RETHROW( (enable) ) }
+
+fc::optional<fc::sha256> object_database::get_state_digest()const
+{
+   if( !_state_digest_enabled )
+      return {};
+   fc::sha256::encoder enc;
+   for( const auto& space : _index )
+      for( const auto& idx : space )
+         if( idx )
+         {
+            fc::raw::pack( enc, idx->get_next_id() );
+            fc::raw::pack( enc, idx->get_state_digest() );
+         }
+   return enc.result();
+}
+
 void object_database::pop_undo()
 { try {
    _undo_db.pop_commit();
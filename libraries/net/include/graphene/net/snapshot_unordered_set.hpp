@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+namespace graphene { namespace net {
+
+/**
+ * A copy-on-write wrapper of std::unordered_set for collections which are iterated much more often than
+ * they are modified, such as the peer connections of a node.
+ *
+ * Readers take an immutable snapshot, and may iterate it while yielding or while the set is being modified,
+ * including by the loop body itself. Taking the snapshot is not lock-free: the atomic shared_ptr operations
+ * are implemented with a pool of mutexes in libstdc++, but such a lock is only held while the pointer is
+ * copied, never while iterating. Writers are serialized, and each modification copies the set, so it is not
+ * suitable for collections with frequent insertions.
+ */
+template <class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key> >
+class snapshot_unordered_set
+{
+public:
+   using set_type = std::unordered_set<Key, Hash, Pred>;
+
+   /// An immutable view of the contents at some point in time, which stays valid after the set changes
+   class snapshot
+   {
+   public:
+      explicit snapshot( std::shared_ptr<const set_type> s ) : _set( std::move(s) ) {}
+
+      typename set_type::const_iterator begin()const { return _set->begin(); }
+      typename set_type::const_iterator end()const { return _set->end(); }
+      typename set_type::const_iterator find( const Key& key )const { return _set->find( key ); }
+      bool   contains( const Key& key )const { return _set->find( key ) != _set->end(); }
+      size_t size()const { return _set->size(); }
+      bool   empty()const { return _set->empty(); }
+
+   private:
+      std::shared_ptr<const set_type> _set;
+   };
+
+   snapshot_unordered_set() : _set( std::make_shared<const set_type>() ) {}
+
+   /// The current contents, to iterate over. This briefly locks to copy the pointer to them.
+   snapshot get_snapshot()const { return snapshot( std::atomic_load( &_set ) ); }
+
+   /// Reads
+   /// @{
+   bool   contains( const Key& key )const { return get_snapshot().contains( key ); }
+   size_t size()const { return get_snapshot().size(); }
+   bool   empty()const { return get_snapshot().empty(); }
+   /// @}
+
+   /// Modifications
+   /// @{
+   bool insert( const Key& key )
+   {
+      return modify( key, false, [&key]( set_type& s ) { return s.insert( key ).second; } );
+   }
+   size_t erase( const Key& key )
+   {
+      return modify( key, true, [&key]( set_type& s ) { return s.erase( key ); } );
+   }
+   void clear()
+   {
+      std::lock_guard<std::mutex> lock( _write_mutex );
+      std::atomic_store( &_set, std::make_shared<const set_type>() );
+   }
+   /// @}
+
+private:
+   /// Apply @p f to a copy of the set and publish it, skipping the copy when the presence of @p key
+   /// shows that @p f would change nothing
+   template <typename Modifier>
+   auto modify( const Key& key, bool needs_key, Modifier&& f ) -> decltype( f( std::declval<set_type&>() ) )
+   {
+      std::lock_guard<std::mutex> lock( _write_mutex );
+      if( ( _set->find( key ) != _set->end() ) != needs_key )
+         return {};
+      auto copy = std::make_shared<set_type>( *_set );
+      auto result = f( *copy );
+      if( result )
+         std::atomic_store( &_set, std::shared_ptr<const set_type>( std::move(copy) ) );
+      return result;
+   }
+
+   std::shared_ptr<const set_type> _set;
+   std::mutex                      _write_mutex;
+};
+
+} } // graphene::net
@@ -175,8 +175,7 @@ namespace graphene { namespace net { namespace detail {
       _node_is_shutting_down = true;
 
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& active_peer : _active_connections)
+         for (const peer_connection_ptr& active_peer : _active_connections.get_snapshot())
          {
             fc::optional<fc::ip::endpoint> inbound_endpoint = active_peer->get_endpoint_for_connecting();
             if (inbound_endpoint)
@@ -421,8 +420,7 @@ namespace graphene { namespace net { namespace detail {
             std::set<item_hash_t> sync_items_to_request;
 
             // for each idle peer that we're syncing with
-            fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-            for( const peer_connection_ptr& peer : _active_connections )
+            for( const peer_connection_ptr& peer : _active_connections.get_snapshot() )
             {
               if( peer->we_need_sync_items_from_peer &&
                   // if we've already scheduled a request for this peer, don't consider scheduling another
@@ -485,8 +483,7 @@ namespace graphene { namespace net { namespace detail {
 
     bool node_impl::is_item_in_any_peers_inventory(const item_id& item) const
     {
-      fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-      for( const peer_connection_ptr& peer : _active_connections )
+      for( const peer_connection_ptr& peer : _active_connections.get_snapshot() )
       {
         if (peer->inventory_peer_advertised_to_us.find(item) != peer->inventory_peer_advertised_to_us.end() )
           return true;
@@ -529,8 +526,7 @@ namespace graphene { namespace net { namespace detail {
 
         // initialize the fetch_messages_to_send with an empty set of items for all idle peers
         {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& peer : _active_connections)
+         for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
             if (peer->idle())
                items_by_peer.insert(peer_and_items_to_fetch(peer));
         }
@@ -646,8 +642,7 @@ namespace graphene { namespace net { namespace detail {
         // we're computing the messages)
         std::list<std::pair<peer_connection_ptr, item_ids_inventory_message> > inventory_messages_to_send;
         {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& peer : _active_connections)
+         for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
          {
           // only advertise to peers who are in sync with us
           idump((peer->peer_needs_sync_items_from_us));
@@ -748,8 +743,7 @@ namespace graphene { namespace net { namespace detail {
       uint32_t handshaking_timeout = _peer_inactivity_timeout;
       fc::time_point handshaking_disconnect_threshold = fc::time_point::now() - fc::seconds(handshaking_timeout);
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         for( const peer_connection_ptr& handshaking_peer : _handshaking_connections )
+         for( const peer_connection_ptr& handshaking_peer : _handshaking_connections.get_snapshot() )
          {
             if( handshaking_peer->connection_initiation_time < handshaking_disconnect_threshold &&
                   handshaking_peer->get_last_message_received_time() < handshaking_disconnect_threshold &&
@@ -771,7 +765,7 @@ namespace graphene { namespace net { namespace detail {
                peers_to_disconnect_forcibly.push_back( handshaking_peer );
             } // if
          } // for
-      } // scoped_lock
+      }
       // timeout for any active peers is two block intervals
       uint32_t active_disconnect_timeout = 10 * _recent_block_interval_seconds;
       uint32_t active_send_keepalive_timeout = active_disconnect_timeout / 2;
@@ -790,9 +784,7 @@ namespace graphene { namespace net { namespace detail {
       fc::time_point active_send_keepalive_threshold = fc::time_point::now() - fc::seconds(active_send_keepalive_timeout);
       fc::time_point active_ignored_request_threshold = fc::time_point::now() - active_ignored_request_timeout;
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-
-         for( const peer_connection_ptr& active_peer : _active_connections )
+         for( const peer_connection_ptr& active_peer : _active_connections.get_snapshot() )
          {
             if( active_peer->connection_initiation_time < active_disconnect_threshold &&
                   active_peer->get_last_message_received_time() < active_disconnect_threshold )
@@ -859,12 +851,11 @@ namespace graphene { namespace net { namespace detail {
                }
             } // else
          } // for
-      } // scoped_lock
+      }
 
       fc::time_point closing_disconnect_threshold = fc::time_point::now() - fc::seconds(GRAPHENE_NET_PEER_DISCONNECT_TIMEOUT);
       {
-         fc::scoped_lock<fc::mutex> lock(_closing_connections.get_mutex());
-         for( const peer_connection_ptr& closing_peer : _closing_connections )
+         for( const peer_connection_ptr& closing_peer : _closing_connections.get_snapshot() )
          {
             if( closing_peer->connection_closed_time < closing_disconnect_threshold )
             {
@@ -875,12 +866,11 @@ namespace graphene { namespace net { namespace detail {
                peers_to_disconnect_forcibly.push_back( closing_peer );
             }
          } // for
-      } // scoped_lock
+      }
       uint32_t failed_terminate_timeout_seconds = 120;
       fc::time_point failed_terminate_threshold = fc::time_point::now() - fc::seconds(failed_terminate_timeout_seconds);
       {
-         fc::scoped_lock<fc::mutex> lock(_terminating_connections.get_mutex());
-         for (const peer_connection_ptr& peer : _terminating_connections )
+         for (const peer_connection_ptr& peer : _terminating_connections.get_snapshot())
          {
             if (peer->get_connection_terminated_time() != fc::time_point::min() &&
                peer->get_connection_terminated_time() < failed_terminate_threshold)
@@ -889,7 +879,7 @@ namespace graphene { namespace net { namespace detail {
                peers_to_terminate.push_back(peer);
             }
          }
-      } // scoped_lock
+      }
       // That's the end of the sorting step; now all peers that require further processing are now in one of the
       // lists peers_to_disconnect_gently,  peers_to_disconnect_forcibly, peers_to_send_keep_alive, or peers_to_terminate
 
@@ -897,14 +887,13 @@ namespace graphene { namespace net { namespace detail {
       // and once we start yielding, we may find that we've moved that peer to another list (closed or active)
       // and that triggers assertions, maybe even errors
       {
-         fc::scoped_lock<fc::mutex> lock(_terminating_connections.get_mutex());
          for (const peer_connection_ptr& peer : peers_to_terminate )
          {
-            assert(_terminating_connections.find(peer) != _terminating_connections.end());
+            assert(_terminating_connections.contains(peer));
             _terminating_connections.erase(peer);
             schedule_peer_for_deletion(peer);
          }
-      } // scoped_lock
+      }
       peers_to_terminate.clear();
 
       // if we're going to abruptly disconnect anyone, do it here 
@@ -922,13 +911,12 @@ namespace graphene { namespace net { namespace detail {
       for( const peer_connection_ptr& peer : peers_to_disconnect_gently )
       {
          {
-            fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
             fc::exception detailed_error( FC_LOG_MESSAGE(warn, "Disconnecting due to inactivity",
                   ( "last_message_received_seconds_ago", (peer->get_last_message_received_time() 
                   - fc::time_point::now() ).count() / fc::seconds(1 ).count() )
                   ( "last_message_sent_seconds_ago", (peer->get_last_message_sent_time() 
                   - fc::time_point::now() ).count() / fc::seconds(1 ).count() )
-                  ( "inactivity_timeout", _active_connections.find(peer ) != _active_connections.end() 
+                  ( "inactivity_timeout", _active_connections.contains(peer ) 
                   ? _peer_inactivity_timeout * 10 : _peer_inactivity_timeout ) ) );
             disconnect_from_peer( peer.get(), "Disconnecting due to inactivity", false, detailed_error );
          }
@@ -962,9 +950,8 @@ namespace graphene { namespace net { namespace detail {
       VERIFY_CORRECT_THREAD();
       
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         // JMJ 2018-10-22 Unsure why we're making a copy here, but this is probably unnecessary
-         std::list<peer_connection_ptr> original_active_peers(_active_connections.begin(), _active_connections.end());
+         // a snapshot, since sending may yield and the active connections may change meanwhile
+         const auto original_active_peers = _active_connections.get_snapshot();
          for( const peer_connection_ptr& active_peer : original_active_peers )
          {
             try
@@ -1085,10 +1072,10 @@ namespace graphene { namespace net { namespace detail {
     {
       VERIFY_CORRECT_THREAD();
 
-      assert(_handshaking_connections.find(peer_to_delete) == _handshaking_connections.end());
-      assert(_active_connections.find(peer_to_delete) == _active_connections.end());
-      assert(_closing_connections.find(peer_to_delete) == _closing_connections.end());
-      assert(_terminating_connections.find(peer_to_delete) == _terminating_connections.end());
+      assert(!_handshaking_connections.contains(peer_to_delete));
+      assert(!_active_connections.contains(peer_to_delete));
+      assert(!_closing_connections.contains(peer_to_delete));
+      assert(!_terminating_connections.contains(peer_to_delete));
 
 #ifdef USE_PEERS_TO_DELETE_MUTEX
       dlog("scheduling peer for deletion: ${peer} (may block on a mutex here)",
@@ -1154,14 +1141,12 @@ namespace graphene { namespace net { namespace detail {
     peer_connection_ptr node_impl::get_peer_by_node_id(const node_id_t& node_id)
     {
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& active_peer : _active_connections)
+         for (const peer_connection_ptr& active_peer : _active_connections.get_snapshot())
             if (node_id == active_peer->node_id)
                return active_peer;
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         for (const peer_connection_ptr& handshaking_peer : _handshaking_connections)
+         for (const peer_connection_ptr& handshaking_peer : _handshaking_connections.get_snapshot())
             if (node_id == handshaking_peer->node_id)
                return handshaking_peer;
       }
@@ -1177,8 +1162,7 @@ namespace graphene { namespace net { namespace detail {
         return true;
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& active_peer : _active_connections)
+         for (const peer_connection_ptr& active_peer : _active_connections.get_snapshot())
          {
             if (node_id == active_peer->node_id)
             {
@@ -1188,8 +1172,7 @@ namespace graphene { namespace net { namespace detail {
          }
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         for (const peer_connection_ptr& handshaking_peer : _handshaking_connections)
+         for (const peer_connection_ptr& handshaking_peer : _handshaking_connections.get_snapshot())
             if (node_id == handshaking_peer->node_id)
             {
                dlog("is_already_connected_to_id returning true because the peer is already in our handshaking list");
@@ -1228,8 +1211,7 @@ namespace graphene { namespace net { namespace detail {
       dlog("   my id is ${id}", ("id", _node_id));
 
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& active_connection : _active_connections)
+         for (const peer_connection_ptr& active_connection : _active_connections.get_snapshot())
          {
             dlog("        active: ${endpoint} with ${id}   [${direction}]",
                   ("endpoint", active_connection->get_remote_endpoint())
@@ -1238,8 +1220,7 @@ namespace graphene { namespace net { namespace detail {
          }
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         for (const peer_connection_ptr& handshaking_connection : _handshaking_connections)
+         for (const peer_connection_ptr& handshaking_connection : _handshaking_connections.get_snapshot())
          {
             dlog("   handshaking: ${endpoint} with ${id}  [${direction}]",
                   ("endpoint", handshaking_connection->get_remote_endpoint())
@@ -1669,8 +1650,7 @@ namespace graphene { namespace net { namespace detail {
       if (!_peer_advertising_disabled)
       {
         reply.addresses.reserve(_active_connections.size());
-        fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-        for (const peer_connection_ptr& active_peer : _active_connections)
+        for (const peer_connection_ptr& active_peer : _active_connections.get_snapshot())
         {
           fc::optional<potential_peer_record> updated_peer_record = _potential_peer_db.lookup_entry_for_endpoint(*active_peer->get_remote_endpoint());
           if (updated_peer_record)
@@ -1707,7 +1687,7 @@ namespace graphene { namespace net { namespace detail {
       if (new_information_received)
         trigger_p2p_network_connect_loop();
 
-      if (_handshaking_connections.find(originating_peer->shared_from_this()) != _handshaking_connections.end())
+      if (_handshaking_connections.contains(originating_peer->shared_from_this()))
       {
         // if we were handshaking, we need to continue with the next step in handshaking (which is either
         // ending handshaking and starting synchronization or disconnecting)
@@ -1836,7 +1816,7 @@ namespace graphene { namespace net { namespace detail {
         }
 
       if (originating_peer->direction == peer_connection_direction::inbound &&
-          _handshaking_connections.find(originating_peer->shared_from_this()) != _handshaking_connections.end())
+          _handshaking_connections.contains(originating_peer->shared_from_this()))
       {
         // handshaking is done, move the connection to fully active status and start synchronizing
         dlog("peer ${endpoint} which was handshaking with us has started synchronizing with us, start syncing with it",
@@ -1860,8 +1840,7 @@ namespace graphene { namespace net { namespace detail {
     {
       VERIFY_CORRECT_THREAD();
       uint32_t max_number_of_unfetched_items = 0;
-      fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-      for( const peer_connection_ptr& peer : _active_connections )
+      for( const peer_connection_ptr& peer : _active_connections.get_snapshot() )
       {
         uint32_t this_peer_unfetched_items_count = (uint32_t)peer->ids_of_items_to_get.size()
                                                  + peer->number_of_unfetched_item_ids;
@@ -2087,8 +2066,7 @@ namespace graphene { namespace net { namespace detail {
           {
             bool is_first_item_for_other_peer = false;
             {
-               fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-               for (const peer_connection_ptr& peer : _active_connections)
+               for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
                {
                   if (peer != originating_peer->shared_from_this() &&
                         !peer->ids_of_items_to_get.empty() &&
@@ -2396,8 +2374,7 @@ namespace graphene { namespace net { namespace detail {
         bool we_advertised_this_item_to_a_peer = false;
         bool we_requested_this_item_from_a_peer = false;
         {
-           fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-            for (const peer_connection_ptr& peer : _active_connections)
+            for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
             {
                if (peer->inventory_advertised_to_peer.find(advertised_item_id) != peer->inventory_advertised_to_peer.end())
                {
@@ -2509,7 +2486,7 @@ namespace graphene { namespace net { namespace detail {
       _closing_connections.erase(originating_peer_ptr);
       _handshaking_connections.erase(originating_peer_ptr);
       _terminating_connections.erase(originating_peer_ptr);
-      if (_active_connections.find(originating_peer_ptr) != _active_connections.end())
+      if (_active_connections.contains(originating_peer_ptr))
       {
         _active_connections.erase(originating_peer_ptr);
 
@@ -2644,9 +2621,7 @@ namespace graphene { namespace net { namespace detail {
                ("count", _total_num_of_unfetched_items));
          bool is_fork_block = is_hard_fork_block(block_message_to_send.block.block_num());
          {
-            fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-
-            for (const peer_connection_ptr& peer : _active_connections)
+            for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
             {
                bool disconnecting_this_peer = false;
                if (is_fork_block)
@@ -2719,8 +2694,7 @@ namespace graphene { namespace net { namespace detail {
       else
       {
         // invalid message received
-        fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-        for (const peer_connection_ptr& peer : _active_connections)
+        for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
         {
           if (peer->ids_of_items_being_processed.find(block_message_to_send.block_id)
                  != peer->ids_of_items_being_processed.end())
@@ -2825,8 +2799,7 @@ namespace graphene { namespace net { namespace detail {
           // find out if this block is the next block on the active chain or one of the forks
           bool potential_first_block = false;
           {
-            fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-            for (const peer_connection_ptr& peer : _active_connections)
+            for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
             {
                if (!peer->ids_of_items_to_get.empty() &&
                      peer->ids_of_items_to_get.front() == received_block_iter->block_id)
@@ -2862,8 +2835,7 @@ namespace graphene { namespace net { namespace detail {
             {
               dlog("Already received and accepted this block (presumably through normal inventory mechanism), treating it as accepted");
               std::vector< peer_connection_ptr > peers_needing_next_batch;
-              fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-              for (const peer_connection_ptr& peer : _active_connections)
+              for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
               {
                 auto items_being_processed_iter = peer->ids_of_items_being_processed.find(received_block_iter->block_id);
                 if (items_being_processed_iter != peer->ids_of_items_being_processed.end())
@@ -2991,8 +2963,7 @@ namespace graphene { namespace net { namespace detail {
         uint32_t block_number = block_message_to_process.block.block_num();
         fc::time_point_sec block_time = block_message_to_process.block.timestamp;
         {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& peer : _active_connections)
+         for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
          {
             auto iter = peer->inventory_peer_advertised_to_us.find(block_message_item_id);
             if (iter != peer->inventory_peer_advertised_to_us.end())
@@ -3016,8 +2987,7 @@ namespace graphene { namespace net { namespace detail {
         {
           // we just pushed a hard fork block.  Find out if any of our peers are running clients
           // that will be unable to process future blocks
-          fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-          for (const peer_connection_ptr& peer : _active_connections)
+          for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
           {
             if (peer->last_known_fork_block_number != 0)
             {
@@ -3071,8 +3041,7 @@ namespace graphene { namespace net { namespace detail {
         disconnect_reason = "You offered me a block that I have deemed to be invalid";
 
         peers_to_disconnect.insert( originating_peer->shared_from_this() );
-        fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-        for (const peer_connection_ptr& peer : _active_connections)
+        for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
           if (!peer->ids_of_items_to_get.empty() && peer->ids_of_items_to_get.front() == block_message_to_process.block_id)
             peers_to_disconnect.insert(peer);
       }
@@ -3203,8 +3172,7 @@ namespace graphene { namespace net { namespace detail {
     void node_impl::forward_firewall_check_to_next_available_peer(firewall_check_state_data* firewall_check_state)
     {
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& peer : _active_connections)
+         for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
          {
             if (firewall_check_state->expected_node_id != peer->node_id && // it's not the node who is asking us to test
                   !peer->firewall_check_state && // the peer isn't already performing a check for another node
@@ -3472,8 +3440,7 @@ namespace graphene { namespace net { namespace detail {
 
     void node_impl::start_synchronizing()
     {
-      fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-      for( const peer_connection_ptr& peer : _active_connections )
+      for( const peer_connection_ptr& peer : _active_connections.get_snapshot() )
         start_synchronizing_with_peer( peer );
     }
 
@@ -3679,16 +3646,16 @@ namespace graphene { namespace net { namespace detail {
       std::list<peer_connection_ptr> all_peers;
       auto p_back = [&all_peers](const peer_connection_ptr& conn) { all_peers.push_back(conn); };
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         std::for_each(_active_connections.begin(), _active_connections.end(), p_back);
+         const auto snapshot = _active_connections.get_snapshot();
+         std::for_each(snapshot.begin(), snapshot.end(), p_back);
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         std::for_each(_handshaking_connections.begin(), _handshaking_connections.end(), p_back);
+         const auto snapshot = _handshaking_connections.get_snapshot();
+         std::for_each(snapshot.begin(), snapshot.end(), p_back);
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_closing_connections.get_mutex());
-         std::for_each(_closing_connections.begin(), _closing_connections.end(), p_back);
+         const auto snapshot = _closing_connections.get_snapshot();
+         std::for_each(snapshot.begin(), snapshot.end(), p_back);
       }
 
       for (const peer_connection_ptr& peer : all_peers)
@@ -3976,9 +3943,9 @@ namespace graphene { namespace net { namespace detail {
         // whether the peer is firewalled, we want to disconnect now.
         _handshaking_connections.erase(new_peer);
         _terminating_connections.erase(new_peer);
-        assert(_active_connections.find(new_peer) == _active_connections.end());
+        assert(!_active_connections.contains(new_peer));
         _active_connections.erase(new_peer);
-        assert(_closing_connections.find(new_peer) == _closing_connections.end());
+        assert(!_closing_connections.contains(new_peer));
         _closing_connections.erase(new_peer);
 
         display_current_connections();
@@ -4296,8 +4263,7 @@ namespace graphene { namespace net { namespace detail {
     {
       VERIFY_CORRECT_THREAD();
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for( const peer_connection_ptr& active_peer : _active_connections )
+         for( const peer_connection_ptr& active_peer : _active_connections.get_snapshot() )
          {
             fc::optional<fc::ip::endpoint> endpoint_for_this_peer( active_peer->get_remote_endpoint() );
             if( endpoint_for_this_peer && *endpoint_for_this_peer == remote_endpoint )
@@ -4305,8 +4271,7 @@ namespace graphene { namespace net { namespace detail {
          }
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         for( const peer_connection_ptr& handshaking_peer : _handshaking_connections )
+         for( const peer_connection_ptr& handshaking_peer : _handshaking_connections.get_snapshot() )
          {
             fc::optional<fc::ip::endpoint> endpoint_for_this_peer( handshaking_peer->get_remote_endpoint() );
             if( endpoint_for_this_peer && *endpoint_for_this_peer == remote_endpoint )
@@ -4357,8 +4322,7 @@ namespace graphene { namespace net { namespace detail {
            ( "active", _active_connections.size() )("handshaking", _handshaking_connections.size() )("closing",_closing_connections.size() )
            ( "desired", _desired_number_of_connections )("maximum", _maximum_number_of_connections ) );
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for( const peer_connection_ptr& peer : _active_connections )
+         for( const peer_connection_ptr& peer : _active_connections.get_snapshot() )
          {
             ilog( "       active peer ${endpoint} peer_is_in_sync_with_us:${in_sync_with_us} we_are_in_sync_with_peer:${in_sync_with_them}",
                   ( "endpoint", peer->get_remote_endpoint() )
@@ -4371,8 +4335,7 @@ namespace graphene { namespace net { namespace detail {
          }
       }
       {
-         fc::scoped_lock<fc::mutex> lock(_handshaking_connections.get_mutex());
-         for( const peer_connection_ptr& peer : _handshaking_connections )
+         for( const peer_connection_ptr& peer : _handshaking_connections.get_snapshot() )
          {
             ilog( "  handshaking peer ${endpoint} in state ours(${our_state}) theirs(${their_state})",
                   ( "endpoint", peer->get_remote_endpoint() )("our_state", peer->our_state )("their_state", peer->their_state ) );
@@ -4385,8 +4348,7 @@ namespace graphene { namespace net { namespace detail {
       ilog( "node._items_to_fetch size: ${size}", ("size", _items_to_fetch.size() ) );
       ilog( "node._new_inventory size: ${size}", ("size", _new_inventory.size() ) );
       ilog( "node._message_cache size: ${size}", ("size", _message_cache.size() ) );
-      fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-      for( const peer_connection_ptr& peer : _active_connections )
+      for( const peer_connection_ptr& peer : _active_connections.get_snapshot() )
       {
         ilog( "  peer ${endpoint}", ("endpoint", peer->get_remote_endpoint() ) );
         ilog( "    peer.ids_of_items_to_get size: ${size}", ("size", peer->ids_of_items_to_get.size() ) );
@@ -4483,8 +4445,7 @@ namespace graphene { namespace net { namespace detail {
     {
       VERIFY_CORRECT_THREAD();
       std::vector<peer_status> statuses;
-      fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-      for (const peer_connection_ptr& peer : _active_connections)
+      for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
       {
         peer_status this_peer_status;
         this_peer_status.version = 0;
@@ -4633,7 +4594,7 @@ namespace graphene { namespace net { namespace detail {
       _desired_number_of_connections = std::min(_desired_number_of_connections, _maximum_number_of_connections);
 
       while (_active_connections.size() > _maximum_number_of_connections)
-        disconnect_from_peer(_active_connections.begin()->get(),
+        disconnect_from_peer(_active_connections.get_snapshot().begin()->get(),
                              "I have too many connections open");
       trigger_p2p_network_connect_loop();
     }
@@ -4677,8 +4638,7 @@ namespace graphene { namespace net { namespace detail {
       std::list<peer_connection_ptr> peers_to_disconnect;
       if (!_allowed_peers.empty())
       {
-         fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-         for (const peer_connection_ptr& peer : _active_connections)
+         for (const peer_connection_ptr& peer : _active_connections.get_snapshot())
             if (_allowed_peers.find(peer->node_id) == _allowed_peers.end())
                peers_to_disconnect.push_back(peer);
       }
@@ -26,6 +26,7 @@
 #include <graphene/net/node.hpp>
 #include <graphene/net/core_messages.hpp>
 #include <graphene/net/peer_connection.hpp>
+#include <graphene/net/snapshot_unordered_set.hpp>
 
 namespace graphene { namespace net { namespace detail {
 
@@ -502,15 +503,15 @@ class node_impl : public peer_connection_delegate, public std::enable_shared_fro
 
       /// Stores all connections which have not yet finished key exchange or are still sending
       /// initial handshaking messages back and forth (not yet ready to initiate syncing)
-      concurrent_unordered_set<graphene::net::peer_connection_ptr>               _handshaking_connections;
+      snapshot_unordered_set<graphene::net::peer_connection_ptr>                 _handshaking_connections;
       /** Stores fully established connections we're either syncing with or in normal operation with */
-      concurrent_unordered_set<graphene::net::peer_connection_ptr>               _active_connections;
+      snapshot_unordered_set<graphene::net::peer_connection_ptr>                 _active_connections;
       /// Stores connections we've closed (sent closing message, not actually closed),
       /// but are still waiting for the remote end to close before we delete them
-      concurrent_unordered_set<graphene::net::peer_connection_ptr>               _closing_connections;
+      snapshot_unordered_set<graphene::net::peer_connection_ptr>                 _closing_connections;
       /// Stores connections we've closed, but are still waiting for the OS to notify us that the socket
       /// is really closed
-      concurrent_unordered_set<graphene::net::peer_connection_ptr>               _terminating_connections;
+      snapshot_unordered_set<graphene::net::peer_connection_ptr>                 _terminating_connections;
 
       /// The /n/ most recent blocks we've accepted (currently tuned to the max number of connections)
       boost::circular_buffer<item_hash_t> _most_recent_blocks_accepted { _maximum_number_of_connections };
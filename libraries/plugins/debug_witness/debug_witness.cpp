@@ -95,77 +95,56 @@ void debug_witness_plugin::plugin_initialize(const boost::program_options::varia
 void debug_witness_plugin::plugin_startup()
 {
    ilog("debug_witness_plugin::plugin_startup() begin");
-   chain::database& db = database();
-
-   // connect needed signals
-
-   _applied_block_conn  = db.applied_block.connect([this](const graphene::chain::signed_block& b){ on_applied_block(b); });
-   _changed_objects_conn = db.changed_objects.connect([this](const std::vector<graphene::db::object_id_type>& ids, const fc::flat_set<graphene::chain::account_id_type>& impacted_accounts){ on_changed_objects(ids, impacted_accounts); });
-   _removed_objects_conn = db.removed_objects.connect([this](const std::vector<graphene::db::object_id_type>& ids, const std::vector<const graphene::db::object*>& objs, const fc::flat_set<graphene::chain::account_id_type>& impacted_accounts){ on_removed_objects(ids, objs, impacted_accounts); });
 
+   // object changes are only followed while a JSON object stream is open, see set_json_object_stream
 }
 
-void debug_witness_plugin::on_changed_objects( const std::vector<graphene::db::object_id_type>& ids, const fc::flat_set<graphene::chain::account_id_type>& impacted_accounts )
+void debug_witness_plugin::on_object_changes( const graphene::chain::object_change_set& changes )
 {
-   if( _json_object_stream && (ids.size() > 0) )
-   {
-      const chain::database& db = database();
-      for( const graphene::db::object_id_type& oid : ids )
-      {
-         const graphene::db::object* obj = db.find_object( oid );
-         if( obj != nullptr )
-         {
-            (*_json_object_stream) << fc::json::to_string( obj->to_variant() ) << '\n';
-         }
-      }
-   }
+   (*_json_object_stream) << "{\"bn\":" << fc::to_string( changes.block_num ) << "}\n";
+   for( const auto& obj : changes.changed_objects )
+      (*_json_object_stream) << fc::json::to_string( obj->to_variant() ) << '\n';
+   for( const auto& obj : changes.removed_objects )
+      (*_json_object_stream) << "{\"id\":" << fc::json::to_string( obj->id ) << "}\n";
 }
 
-void debug_witness_plugin::on_removed_objects( const std::vector<graphene::db::object_id_type>& ids, const std::vector<const graphene::db::object*> objs, const fc::flat_set<graphene::chain::account_id_type>& impacted_accounts )
+void debug_witness_plugin::set_json_object_stream( const std::string& filename )
 {
-   if( _json_object_stream )
-   {
-      for( const graphene::db::object* obj : objs )
-      {
-         (*_json_object_stream) << "{\"id\":" << fc::json::to_string( obj->id ) << "}\n";
-      }
-   }
+   cleanup();
+   _json_object_stream = std::make_shared< std::ofstream >( filename );
+   // written on the notifier thread, so that dumping objects does not delay block application
+   _json_subscription = database().deferred_object_changes.subscribe( "debug_witness JSON object stream",
+         [this]( const graphene::chain::object_change_set& changes ) { on_object_changes( changes ); },
+         json_object_queue_size );
 }
 
-void debug_witness_plugin::on_applied_block( const graphene::chain::signed_block& b )
+void debug_witness_plugin::flush_json_object_stream()
 {
    if( _json_object_stream )
    {
-      (*_json_object_stream) << "{\"bn\":" << fc::to_string( b.block_num() ) << "}\n";
+      database().deferred_object_changes.flush();
+      _json_object_stream->flush();
    }
 }
 
-void debug_witness_plugin::set_json_object_stream( const std::string& filename )
+void debug_witness_plugin::cleanup()
 {
+   if( _json_subscription.valid() )
+   {
+      auto& notifier = database().deferred_object_changes;
+      notifier.unsubscribe( *_json_subscription );
+      // wait for a delivery that may still be writing to the stream
+      notifier.flush();
+      _json_subscription.reset();
+   }
    if( _json_object_stream )
    {
       _json_object_stream->close();
       _json_object_stream.reset();
    }
-   _json_object_stream = std::make_shared< std::ofstream >( filename );
-}
-
-void debug_witness_plugin::flush_json_object_stream()
-{
-   if( _json_object_stream )
-      _json_object_stream->flush();
 }
 
 void debug_witness_plugin::plugin_shutdown()
 {
    cleanup();
 }
-
-void debug_witness_plugin::cleanup()
-{
-   if( _json_object_stream )
-   {
-      _json_object_stream->close();
-      _json_object_stream.reset();
-   }
-}
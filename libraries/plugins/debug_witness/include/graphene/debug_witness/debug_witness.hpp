@@ -54,18 +54,18 @@ public:
 private:
    void cleanup();
 
-   void on_changed_objects( const std::vector<graphene::db::object_id_type>& ids, const fc::flat_set<graphene::chain::account_id_type>& impacted_accounts );
-   void on_removed_objects( const std::vector<graphene::db::object_id_type>& ids, const std::vector<const graphene::db::object*> objs, const fc::flat_set<graphene::chain::account_id_type>& impacted_accounts );
-   void on_applied_block( const graphene::chain::signed_block& b );
+   /// Writes a block number marker, then the changed objects and the ids of the removed objects
+   void on_object_changes( const graphene::chain::object_change_set& changes );
 
    boost::program_options::variables_map _options;
 
    std::map<chain::public_key_type, fc::ecc::private_key, chain::pubkey_comparator> _private_keys;
 
+   /// Change sets of blocks waiting to be written, more are dropped and counted in the notifier stats
+   static constexpr uint32_t json_object_queue_size = 10000;
+
    std::shared_ptr< std::ofstream > _json_object_stream;
-   boost::signals2::scoped_connection _applied_block_conn;
-   boost::signals2::scoped_connection _changed_objects_conn;
-   boost::signals2::scoped_connection _removed_objects_conn;
+   fc::optional<uint32_t> _json_subscription;
 };
 
 } } //graphene::debug_witness_plugin
@@ -31,6 +31,8 @@
 #include <fc/rpc/websocket_api.hpp>
 #include <fc/api.hpp>
 
+#include <deque>
+
 namespace graphene { namespace delayed_node {
 namespace bpo = boost::program_options;
 
@@ -43,6 +45,8 @@ struct delayed_node_plugin_impl {
    boost::signals2::scoped_connection client_connection_closed;
    graphene::chain::block_id_type last_received_remote_head;
    graphene::chain::block_id_type last_processed_remote_head;
+   /// Maximum number of blocks being fetched and precomputed ahead of the block being applied
+   uint32_t sync_window = 32;
 };
 }
 
@@ -59,6 +63,8 @@ void delayed_node_plugin::plugin_set_program_options(bpo::options_description& c
    cli.add_options()
          ("trusted-node", boost::program_options::value<std::string>(),
           "RPC endpoint of a trusted validating node (required for delayed_node)")
+         ("delayed-node-sync-window", boost::program_options::value<uint32_t>()->default_value(32),
+          "Maximum number of blocks to request from the trusted node ahead of the block being applied (default: 32)")
          ;
    cfg.add(cli);
 }
@@ -93,6 +99,11 @@ void delayed_node_plugin::plugin_initialize(const boost::program_options::variab
    FC_ASSERT(options.count("trusted-node") > 0);
    my = std::make_unique<detail::delayed_node_plugin_impl>();
    my->remote_endpoint = "ws://" + options.at("trusted-node").as<std::string>();
+   if( options.count("delayed-node-sync-window") > 0 )
+   {
+      my->sync_window = options.at("delayed-node-sync-window").as<uint32_t>();
+      FC_ASSERT( my->sync_window > 0, "delayed-node-sync-window must be positive" );
+   }
 }
 
 void delayed_node_plugin::sync_with_trusted_node()
@@ -116,19 +127,48 @@ void delayed_node_plugin::sync_with_trusted_node()
          break;
       }
       pass_count++;
-      while( remote_dpo.last_irreversible_block_num > db.head_block_num() )
+      // Blocks are requested from the trusted node and precomputed in a window ahead of the head block,
+      // while they are applied strictly in order here.
+      const uint32_t target_block_num = remote_dpo.last_irreversible_block_num;
+      uint32_t next_block_num = db.head_block_num() + 1;
+      std::deque< fc::future<graphene::chain::signed_block> > pending_blocks;
+      try
       {
-         fc::optional<graphene::chain::signed_block> block = my->database_api->get_block( db.head_block_num()+1 );
-         // TODO: during sync, decouple requesting blocks from preprocessing + applying them
-         FC_ASSERT(block, "Trusted node claims it has blocks it doesn't actually have.");
-         ilog("Pushing block #${n}", ("n", block->block_num()));
-         db.precompute_parallel( *block, graphene::chain::database::skip_nothing ).wait();
-         db.push_block(*block);
-         synced_blocks++;
+         while( target_block_num > db.head_block_num() )
+         {
+            while( next_block_num <= target_block_num && pending_blocks.size() < my->sync_window )
+            {
+               pending_blocks.push_back( fetch_block( next_block_num ) );
+               ++next_block_num;
+            }
+            graphene::chain::signed_block block = pending_blocks.front().wait();
+            pending_blocks.pop_front();
+            ilog("Pushing block #${n}", ("n", block.block_num()));
+            db.push_block(block);
+            synced_blocks++;
+         }
+      }
+      catch( const fc::exception& )
+      {
+         for( auto& pending : pending_blocks )
+            pending.cancel_and_wait( "delayed_node sync aborted" );
+         throw;
       }
    }
 }
 
+fc::future<graphene::chain::signed_block> delayed_node_plugin::fetch_block( uint32_t block_num )
+{
+   return fc::async( [this,block_num]() {
+      fc::optional<graphene::chain::signed_block> block = my->database_api->get_block( block_num );
+      FC_ASSERT(block, "Trusted node claims it has blocks it doesn't actually have.");
+      FC_ASSERT( block->block_num() == block_num, "Trusted node returned block #${n} instead of #${e}",
+                 ("n", block->block_num())("e", block_num) );
+      database().precompute_parallel( *block, graphene::chain::database::skip_nothing ).wait();
+      return *block;
+   }, "delayed_node fetch block" );
+}
+
 void delayed_node_plugin::mainloop()
 {
    while( true )
@@ -24,6 +24,9 @@
 #pragma once
 
 #include <graphene/app/plugin.hpp>
+#include <graphene/protocol/block.hpp>
+
+#include <fc/thread/future.hpp>
 
 namespace graphene { namespace delayed_node {
 namespace detail { struct delayed_node_plugin_impl; }
@@ -46,6 +49,8 @@ protected:
    void connection_failed();
    void connect();
    void sync_with_trusted_node();
+   /// Requests a block from the trusted node and precomputes it in the background
+   fc::future<graphene::protocol::signed_block> fetch_block( uint32_t block_num );
 };
 
 } } //graphene::account_history
@@ -33,6 +33,13 @@
 
 #include <graphene/utilities/elasticsearch.hpp>
 
+#include <fc/asio.hpp>
+#include <fc/thread/parallel.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <atomic>
+#include <deque>
+
 namespace graphene { namespace es_objects {
 
 namespace detail
@@ -46,18 +53,25 @@ class es_objects_plugin_impl
       {
          curl = curl_easy_init();
          curl_easy_setopt(curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
+         sender_curl = curl_easy_init();
+         curl_easy_setopt(sender_curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
       }
       virtual ~es_objects_plugin_impl();
 
       bool index_database(const vector<object_id_type>& ids, std::string action);
       bool genesis();
-      void remove_from_database(object_id_type id, std::string index);
+      /// Encodes the pending objects on worker threads and hands them over to the bulk sender
+      void send_pending();
+      /// Waits until all bulks handed over to the bulk sender are sent, rethrows a failure of the sender
+      void wait_for_sender();
 
       es_objects_plugin& _self;
       std::string _es_objects_elasticsearch_url = "http://localhost:9200/";
       std::string _es_objects_auth = "";
       uint32_t _es_objects_bulk_replay = 10000;
       uint32_t _es_objects_bulk_sync = 100;
+      uint32_t _es_objects_max_pending_bulks = 4;
+      uint32_t _es_objects_max_send_retries = 3;
       bool _es_objects_proposals = true;
       bool _es_objects_accounts = true;
       bool _es_objects_assets = true;
@@ -67,8 +81,7 @@ class es_objects_plugin_impl
       std::string _es_objects_index_prefix = "objects-";
       uint32_t _es_objects_start_es_after_block = 0;
       CURL *curl; // curl handler
-      vector <std::string> bulk;
-      vector<std::string> prepare;
+      CURL *sender_curl; // curl handler used by the bulk sender thread
 
       bool _es_objects_keep_only_current = true;
 
@@ -76,10 +89,47 @@ class es_objects_plugin_impl
       fc::time_point_sec block_time;
 
    private:
-      template<typename T>
-      void prepareTemplate(T blockchain_object, string index_name);
+      /// A copy of an object to be exported, or a deletion if obj is null
+      struct pending_object
+      {
+         std::shared_ptr<const graphene::db::object> obj;
+         object_id_type id;
+         std::string index_name;
+         uint32_t block_number;
+         fc::time_point_sec block_time;
+      };
+
+      void add_pending( const graphene::db::object* obj, object_id_type id, const std::string& index_name );
+      vector<std::string> create_bulk_lines( const pending_object& pending )const;
+      bool send_bulk_lines( const vector<std::string>& lines );
+      /// Waits for the oldest bulk handed over to the bulk sender
+      void wait_for_oldest_send();
+
+      /// Objects to be exported, coalesced by id (and by block number if not keeping only the current state)
+      std::map< std::pair<object_id_type, uint32_t>, pending_object > _pending;
+      std::unique_ptr<fc::thread> _sender_thread;
+      /// Bulks handed over to the sender thread, oldest first
+      std::deque< fc::future<void> > _sends;
+      /// Lines of failed bulks, sent in front of the next bulk. Only accessed on the sender thread
+      vector<std::string> _unsent_lines;
+   public:
+      /// Set when shutting down, failed bulks are not retried any more
+      std::atomic<bool> _stopping { false };
 };
 
+void es_objects_plugin_impl::add_pending( const graphene::db::object* obj, object_id_type id,
+                                          const std::string& index_name )
+{
+   if( obj == nullptr && !_es_objects_keep_only_current ) // nothing to delete if keeping the whole history
+      return;
+   pending_object& pending = _pending[ std::make_pair( id, _es_objects_keep_only_current ? 0 : block_number ) ];
+   pending.obj = ( obj == nullptr ? nullptr : std::shared_ptr<const graphene::db::object>( obj->clone() ) );
+   pending.id = id;
+   pending.index_name = index_name;
+   pending.block_number = block_number;
+   pending.block_time = block_time;
+}
+
 bool es_objects_plugin_impl::genesis()
 {
    ilog("elasticsearch OBJECTS: inserting data from genesis");
@@ -91,38 +141,25 @@ bool es_objects_plugin_impl::genesis()
 
    if (_es_objects_accounts) {
       auto &index_accounts = db.get_index(1, 2);
-      index_accounts.inspect_all_objects([this, &db](const graphene::db::object &o) {
-         auto obj = db.find_object(o.id);
-         auto a = static_cast<const account_object *>(obj);
-         prepareTemplate<account_object>(*a, "account");
+      index_accounts.inspect_all_objects([this](const graphene::db::object &o) {
+         add_pending( &o, o.id, "account" );
       });
    }
    if (_es_objects_assets) {
       auto &index_assets = db.get_index(1, 3);
-      index_assets.inspect_all_objects([this, &db](const graphene::db::object &o) {
-         auto obj = db.find_object(o.id);
-         auto a = static_cast<const asset_object *>(obj);
-         prepareTemplate<asset_object>(*a, "asset");
+      index_assets.inspect_all_objects([this](const graphene::db::object &o) {
+         add_pending( &o, o.id, "asset" );
       });
    }
    if (_es_objects_balances) {
       auto &index_balances = db.get_index(2, 5);
-      index_balances.inspect_all_objects([this, &db](const graphene::db::object &o) {
-         auto obj = db.find_object(o.id);
-         auto b = static_cast<const account_balance_object *>(obj);
-         prepareTemplate<account_balance_object>(*b, "balance");
+      index_balances.inspect_all_objects([this](const graphene::db::object &o) {
+         add_pending( &o, o.id, "balance" );
       });
    }
 
-   graphene::utilities::ES es;
-   es.curl = curl;
-   es.bulk_lines = bulk;
-   es.elasticsearch_url = _es_objects_elasticsearch_url;
-   es.auth = _es_objects_auth;
-   if (!graphene::utilities::SendBulk(std::move(es)))
-      FC_THROW_EXCEPTION(graphene::chain::plugin_exception, "Error inserting genesis data.");
-   else
-      bulk.clear();
+   send_pending();
+   wait_for_sender();
 
    return true;
 }
@@ -143,132 +180,173 @@ bool es_objects_plugin_impl::index_database(const vector<object_id_type>& ids, s
       else
          limit_documents = _es_objects_bulk_replay;
 
-
       for (auto const &value: ids) {
-         if (value.is<proposal_object>() && _es_objects_proposals) {
-            auto obj = db.find_object(value);
-            auto p = static_cast<const proposal_object *>(obj);
-            if (p != nullptr) {
-               if (action == "delete")
-                  remove_from_database(p->id, "proposal");
-               else
-                  prepareTemplate<proposal_object>(*p, "proposal");
-            }
-         } else if (value.is<account_object>() && _es_objects_accounts) {
-            auto obj = db.find_object(value);
-            auto a = static_cast<const account_object *>(obj);
-            if (a != nullptr) {
-               if (action == "delete")
-                  remove_from_database(a->id, "account");
-               else
-                  prepareTemplate<account_object>(*a, "account");
-            }
-         } else if (value.is<asset_object>() && _es_objects_assets) {
-            auto obj = db.find_object(value);
-            auto a = static_cast<const asset_object *>(obj);
-            if (a != nullptr) {
-               if (action == "delete")
-                  remove_from_database(a->id, "asset");
-               else
-                  prepareTemplate<asset_object>(*a, "asset");
-            }
-         } else if (value.is<account_balance_object>() && _es_objects_balances) {
-            auto obj = db.find_object(value);
-            auto b = static_cast<const account_balance_object *>(obj);
-            if (b != nullptr) {
-               if (action == "delete")
-                  remove_from_database(b->id, "balance");
-               else
-                  prepareTemplate<account_balance_object>(*b, "balance");
-            }
-         } else if (value.is<limit_order_object>() && _es_objects_limit_orders) {
-            auto obj = db.find_object(value);
-            auto l = static_cast<const limit_order_object *>(obj);
-            if (l != nullptr) {
-               if (action == "delete")
-                  remove_from_database(l->id, "limitorder");
-               else
-                  prepareTemplate<limit_order_object>(*l, "limitorder");
-            }
-         } else if (value.is<asset_bitasset_data_object>() && _es_objects_asset_bitasset) {
-            auto obj = db.find_object(value);
-            auto ba = static_cast<const asset_bitasset_data_object *>(obj);
-            if (ba != nullptr) {
-               if (action == "delete")
-                  remove_from_database(ba->id, "bitasset");
-               else
-                  prepareTemplate<asset_bitasset_data_object>(*ba, "bitasset");
-            }
-         }
-      }
-
-      if (curl && bulk.size() >= limit_documents) { // we are in bulk time, ready to add data to elasticsearech
-
-         graphene::utilities::ES es;
-         es.curl = curl;
-         es.bulk_lines = bulk;
-         es.elasticsearch_url = _es_objects_elasticsearch_url;
-         es.auth = _es_objects_auth;
-
-         if (!graphene::utilities::SendBulk(std::move(es)))
-            return false;
+         std::string index_name;
+         if (value.is<proposal_object>() && _es_objects_proposals)
+            index_name = "proposal";
+         else if (value.is<account_object>() && _es_objects_accounts)
+            index_name = "account";
+         else if (value.is<asset_object>() && _es_objects_assets)
+            index_name = "asset";
+         else if (value.is<account_balance_object>() && _es_objects_balances)
+            index_name = "balance";
+         else if (value.is<limit_order_object>() && _es_objects_limit_orders)
+            index_name = "limitorder";
+         else if (value.is<asset_bitasset_data_object>() && _es_objects_asset_bitasset)
+            index_name = "bitasset";
          else
-            bulk.clear();
+            continue;
+
+         if (action == "delete")
+            add_pending( nullptr, value, index_name );
+         else if( const auto* obj = db.find_object(value) )
+            add_pending( obj, value, index_name );
       }
+
+      if (curl && _pending.size() >= limit_documents) // we are in bulk time, ready to add data to elasticsearech
+         send_pending();
    }
 
    return true;
 }
 
-void es_objects_plugin_impl::remove_from_database( object_id_type id, std::string index)
+vector<std::string> es_objects_plugin_impl::create_bulk_lines( const pending_object& pending )const
 {
-   if(_es_objects_keep_only_current)
+   if( !pending.obj )
    {
       fc::mutable_variant_object delete_line;
-      delete_line["_id"] = string(id);
-      delete_line["_index"] = _es_objects_index_prefix + index;
+      delete_line["_id"] = string(pending.id);
+      delete_line["_index"] = _es_objects_index_prefix + pending.index_name;
       delete_line["_type"] = "data";
       fc::mutable_variant_object final_delete_line;
       final_delete_line["delete"] = delete_line;
-      prepare.push_back(fc::json::to_string(final_delete_line));
-      std::move(prepare.begin(), prepare.end(), std::back_inserter(bulk));
-      prepare.clear();
+      return { fc::json::to_string(final_delete_line) };
    }
-}
 
-template<typename T>
-void es_objects_plugin_impl::prepareTemplate(T blockchain_object, string index_name)
-{
    fc::mutable_variant_object bulk_header;
-   bulk_header["_index"] = _es_objects_index_prefix + index_name;
+   bulk_header["_index"] = _es_objects_index_prefix + pending.index_name;
    bulk_header["_type"] = "data";
    if(_es_objects_keep_only_current)
    {
-      bulk_header["_id"] = string(blockchain_object.id);
+      bulk_header["_id"] = string(pending.id);
    }
 
    adaptor_struct adaptor;
-   fc::variant blockchain_object_variant;
-   fc::to_variant( blockchain_object, blockchain_object_variant, GRAPHENE_NET_MAX_NESTED_OBJECTS );
+   fc::variant blockchain_object_variant = pending.obj->to_variant();
    fc::mutable_variant_object o = adaptor.adapt(blockchain_object_variant.get_object());
 
-   o["object_id"] = string(blockchain_object.id);
-   o["block_time"] = block_time;
-   o["block_number"] = block_number;
+   o["object_id"] = string(pending.id);
+   o["block_time"] = pending.block_time;
+   o["block_number"] = pending.block_number;
 
    string data = fc::json::to_string(o, fc::json::legacy_generator);
 
-   prepare = graphene::utilities::createBulk(bulk_header, std::move(data));
-   std::move(prepare.begin(), prepare.end(), std::back_inserter(bulk));
-   prepare.clear();
+   return graphene::utilities::createBulk(bulk_header, std::move(data));
+}
+
+void es_objects_plugin_impl::send_pending()
+{
+   if( _pending.empty() )
+      return;
+
+   // report failed bulks as early as possible, and do not let more than a few bulks pile up in front of
+   // a slow ES node. Waiting yields, so that the thread keeps serving other tasks meanwhile.
+   // Note: this is done before taking the pending objects, so that they are kept if a bulk failed.
+   while( !_sends.empty() && _sends.front().ready() )
+      wait_for_oldest_send();
+   while( _sends.size() >= _es_objects_max_pending_bulks )
+      wait_for_oldest_send();
+
+   auto objects = std::make_shared< vector<pending_object> >();
+   objects->reserve( _pending.size() );
+   for( auto& item : _pending )
+      objects->emplace_back( std::move( item.second ) );
+   _pending.clear();
+
+   // encode in parallel
+   const size_t chunks = std::min<size_t>( fc::asio::default_io_service_scope::get_num_threads(), objects->size() );
+   const size_t chunk_size = ( objects->size() + chunks - 1 ) / chunks;
+   vector< fc::future< vector<std::string> > > encoders;
+   encoders.reserve( chunks );
+   for( size_t base = 0; base < objects->size(); base += chunk_size )
+   {
+      encoders.push_back( fc::do_parallel( [this,objects,base,chunk_size] () {
+         vector<std::string> lines;
+         const size_t end = std::min( base + chunk_size, objects->size() );
+         for( size_t i = base; i < end; ++i )
+         {
+            auto object_lines = create_bulk_lines( (*objects)[i] );
+            std::move( object_lines.begin(), object_lines.end(), std::back_inserter(lines) );
+         }
+         return lines;
+      }) );
+   }
+
+   if( !_sender_thread )
+      _sender_thread = std::make_unique<fc::thread>( "es_objects sender" );
+   _sends.push_back( _sender_thread->async( [this,encoders] () mutable {
+      vector<std::string> lines = std::move( _unsent_lines );
+      _unsent_lines.clear();
+      for( auto& encoder : encoders )
+      {
+         auto chunk_lines = encoder.wait();
+         std::move( chunk_lines.begin(), chunk_lines.end(), std::back_inserter(lines) );
+      }
+      if( !send_bulk_lines( lines ) )
+      {
+         const size_t n = lines.size();
+         _unsent_lines = std::move( lines );
+         FC_THROW_EXCEPTION( graphene::chain::plugin_exception,
+               "Error sending ${n} bulk lines to ES database, we are going to keep trying.", ("n", n) );
+      }
+   }, "es_objects send bulk" ) );
+}
+
+bool es_objects_plugin_impl::send_bulk_lines( const vector<std::string>& lines )
+{
+   // Bulks are sent one after another on the sender thread. A failed bulk is retried a few times,
+   // then its lines are kept and sent in front of the next bulk, so that they are not lost or reordered
+   for( uint32_t attempt = 0; ; ++attempt )
+   {
+      graphene::utilities::ES es;
+      es.curl = sender_curl;
+      es.bulk_lines = lines;
+      es.elasticsearch_url = _es_objects_elasticsearch_url;
+      es.auth = _es_objects_auth;
+      if( graphene::utilities::SendBulk(std::move(es)) )
+         return true;
+      if( _stopping || attempt >= _es_objects_max_send_retries )
+         return false;
+      elog( "elasticsearch OBJECTS: error sending ${n} bulk lines, retrying", ("n", lines.size()) );
+      fc::usleep( fc::seconds(1) );
+   }
+}
+
+void es_objects_plugin_impl::wait_for_oldest_send()
+{
+   fc::future<void> send = _sends.front();
+   _sends.pop_front();
+   send.wait();
+}
+
+void es_objects_plugin_impl::wait_for_sender()
+{
+   while( !_sends.empty() )
+      wait_for_oldest_send();
 }
 
 es_objects_plugin_impl::~es_objects_plugin_impl()
 {
+   if( _sender_thread )
+      _sender_thread->quit();
    if (curl) {
       curl_easy_cleanup(curl);
       curl = nullptr;
    }
+   if (sender_curl) {
+      curl_easy_cleanup(sender_curl);
+      sender_curl = nullptr;
+   }
 }
 
 } // end namespace detail
@@ -304,6 +382,10 @@ void es_objects_plugin::plugin_set_program_options(
                "Number of bulk documents to index on replay(10000)")
          ("es-objects-bulk-sync", boost::program_options::value<uint32_t>(),
                "Number of bulk documents to index on a synchronized chain(100)")
+         ("es-objects-max-pending-bulks", boost::program_options::value<uint32_t>(),
+               "Maximum number of bulks waiting to be sent before block processing waits for ES(4)")
+         ("es-objects-max-send-retries", boost::program_options::value<uint32_t>(),
+               "Number of times a failed bulk is retried before block processing fails(3)")
          ("es-objects-proposals", boost::program_options::value<bool>(), "Store proposal objects(true)")
          ("es-objects-accounts", boost::program_options::value<bool>(), "Store account objects(true)")
          ("es-objects-assets", boost::program_options::value<bool>(), "Store asset objects(true)")
@@ -334,6 +416,13 @@ void es_objects_plugin::plugin_initialize(const boost::program_options::variable
    if (options.count("es-objects-bulk-sync") > 0) {
       my->_es_objects_bulk_sync = options["es-objects-bulk-sync"].as<uint32_t>();
    }
+   if (options.count("es-objects-max-pending-bulks") > 0) {
+      my->_es_objects_max_pending_bulks = options["es-objects-max-pending-bulks"].as<uint32_t>();
+      FC_ASSERT( my->_es_objects_max_pending_bulks > 0, "es-objects-max-pending-bulks must be positive" );
+   }
+   if (options.count("es-objects-max-send-retries") > 0) {
+      my->_es_objects_max_send_retries = options["es-objects-max-send-retries"].as<uint32_t>();
+   }
    if (options.count("es-objects-proposals") > 0) {
       my->_es_objects_proposals = options["es-objects-proposals"].as<bool>();
    }
@@ -407,4 +496,20 @@ void es_objects_plugin::plugin_startup()
    ilog("elasticsearch OBJECTS: plugin_startup() begin");
 }
 
+void es_objects_plugin::plugin_shutdown()
+{
+   // failed bulks are not retried any more, so that shutting down does not wait for an unreachable ES node
+   my->_stopping = true;
+   try
+   {
+      my->send_pending();
+      my->wait_for_sender();
+   }
+   catch( const fc::exception& e )
+   {
+      elog( "elasticsearch OBJECTS: error sending the remaining objects while shutting down: ${e}",
+            ("e", e.to_detail_string()) );
+   }
+}
+
 } }
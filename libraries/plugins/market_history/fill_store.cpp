@@ -0,0 +1,726 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/market_history/fill_store.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include <algorithm>
+
+namespace graphene { namespace market_history {
+
+fill_store::fill_store( uint32_t partition_seconds, uint32_t recent_seconds )
+:_partition_seconds( partition_seconds ), _recent_seconds( recent_seconds )
+{
+   FC_ASSERT( _partition_seconds > 0 );
+}
+
+fill_store::~fill_store()
+{
+   close();
+}
+
+void fill_store::open( const fc::path& dir, uint32_t first_new_block )
+{ try {
+   close();
+   _markets.clear();
+   _windows.clear();
+   _recent_by_time.clear();
+   _reversible.clear();
+   _size = 0;
+
+   if( !fc::exists( dir ) )
+      fc::create_directories( dir );
+   _file_path = dir / "fills";
+   _stored_path = dir / "stored_fills";
+
+   vector<fill_record> reopened;
+   const uint32_t stored_until = load_stored_windows( first_new_block, reopened );
+   // blocks are in time order, fills of a market keep their order
+   std::stable_sort( reopened.begin(), reopened.end(), []( const fill_record& a, const fill_record& b ) {
+      return a.block_num < b.block_num;
+   });
+   for( const auto& record : reopened )
+   {
+      add( record );
+      store_old_windows();
+   }
+
+   read_log( first_new_block, stored_until );
+   rewrite_log();
+   ilog( "Loaded ${n} fills from ${d}, ${r} of them in memory", ("n",_size)("d",dir)("r",recent_size()) );
+} FC_CAPTURE_AND_RETHROW( (dir)(first_new_block) ) }
+
+void fill_store::close()
+{
+   if( _file.is_open() )
+   {
+      _file.flush();
+      _file.close();
+   }
+}
+
+uint32_t fill_store::load_stored_windows( uint32_t first_new_block, vector<fill_record>& reopened )
+{
+   _stored_size = 0;
+   if( !fc::exists( _stored_path ) )
+      return 0;
+
+   const uint64_t file_size = fc::file_size( _stored_path );
+   std::ifstream in( _stored_path.generic_string().c_str(), std::ios::in | std::ios::binary );
+   FC_ASSERT( in.is_open(), "Unable to open ${f}", ("f",_stored_path) );
+
+   uint32_t stored_until = 0;
+   uint64_t pos = 0;
+   uint64_t keep_size = 0;
+   while( pos < file_size )
+   {
+      // a window is its header size, its body size, its header and its body
+      uint64_t sizes[2];
+      if( file_size - pos < sizeof(sizes) )
+      {
+         wlog( "Dropping a damaged window at the end of ${f}", ("f",_stored_path) );
+         break;
+      }
+      in.seekg( pos );
+      in.read( reinterpret_cast<char*>( sizes ), sizeof(sizes) );
+      const uint64_t body_pos = pos + sizeof(sizes) + sizes[0];
+      if( sizes[0] > file_size || sizes[1] > file_size || body_pos + sizes[1] > file_size )
+      {
+         wlog( "Dropping a damaged window at the end of ${f}", ("f",_stored_path) );
+         break;
+      }
+      vector<char> header_data( sizes[0] );
+      in.read( header_data.data(), header_data.size() );
+      detail::stored_window_header header;
+      try
+      {
+         header = fc::raw::unpack<detail::stored_window_header>( header_data );
+      }
+      catch( const fc::exception& e )
+      {
+         wlog( "Dropping a damaged window at the end of ${f}: ${e}", ("f",_stored_path)("e",e.to_detail_string()) );
+         break;
+      }
+
+      stored_until = header.start + _partition_seconds;
+      if( header.last_block < first_new_block && keep_size == pos )
+      {
+         register_stored_window( header, body_pos );
+         keep_size = body_pos + sizes[1];
+      }
+      else
+      {
+         // the fills of blocks which will be pushed again are dropped, the others go back to the recent windows
+         for( const auto& location : header.partitions )
+         {
+            const market_key market( location.base, location.quote );
+            stored_partition part_location;
+            part_location.start = header.start;
+            part_location.count = location.count;
+            part_location.pos = body_pos + location.offset;
+            part_location.size = location.size;
+            const partition part = load_partition( part_location );
+            for( size_t i = 0; i < part.size(); ++i )
+            {
+               if( part.block_num[i] < first_new_block )
+                  reopened.push_back( get_record( market, part, i ) );
+            }
+         }
+      }
+      pos = body_pos + sizes[1];
+   }
+
+   in.close();
+   if( keep_size < file_size )
+      fc::resize_file( _stored_path, keep_size );
+   _stored_size = keep_size;
+   return stored_until;
+}
+
+void fill_store::register_stored_window( const detail::stored_window_header& header, uint64_t body_pos )
+{
+   for( const auto& location : header.partitions )
+   {
+      market_fills& fills = _markets[ market_key( location.base, location.quote ) ];
+      fills.stored.emplace_back();
+      stored_partition& part = fills.stored.back();
+      part.start = header.start;
+      part.count = location.count;
+      part.pos = body_pos + location.offset;
+      part.size = location.size;
+      fills.count += location.count;
+      _size += location.count;
+   }
+}
+
+void fill_store::read_log( uint32_t first_new_block, uint32_t stored_until )
+{
+   _file_size = 0;
+   if( !fc::exists( _file_path ) )
+      return;
+
+   std::ifstream in( _file_path.generic_string().c_str(), std::ios::in | std::ios::binary );
+   FC_ASSERT( in.is_open(), "Unable to open ${f}", ("f",_file_path) );
+
+   // read in chunks, a chunk is much larger than a record
+   constexpr size_t chunk_size = 1 << 20;
+   vector<char> buffer;
+   size_t pos = 0;
+   bool at_end = false;
+   while( true )
+   {
+      if( !at_end && buffer.size() - pos < chunk_size )
+      {
+         buffer.erase( buffer.begin(), buffer.begin() + pos );
+         pos = 0;
+         const size_t old_size = buffer.size();
+         buffer.resize( old_size + chunk_size );
+         in.read( buffer.data() + old_size, chunk_size );
+         buffer.resize( old_size + size_t( in.gcount() ) );
+         at_end = ( size_t( in.gcount() ) < chunk_size );
+      }
+      if( pos == buffer.size() )
+         break;
+
+      fill_record record;
+      fc::datastream<const char*> ds( buffer.data() + pos, buffer.size() - pos );
+      try
+      {
+         fc::raw::unpack( ds, record );
+      }
+      catch( const fc::exception& e )
+      {
+         wlog( "Dropping a damaged fill record at the end of ${f}: ${e}", ("f",_file_path)("e",e.to_detail_string()) );
+         break;
+      }
+      pos = buffer.size() - ds.remaining();
+      if( record.block_num >= first_new_block )
+         break;
+      // already in a stored window if the log was not rewritten after the window was stored
+      if( record.time.sec_since_epoch() < stored_until )
+         continue;
+      add( record );
+      store_old_windows();
+   }
+}
+
+void fill_store::rewrite_log()
+{
+   const fc::path tmp_path( _file_path.generic_string() + ".tmp" );
+   {
+      std::ofstream out( tmp_path.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+      FC_ASSERT( out.is_open(), "Unable to open ${f}", ("f",tmp_path) );
+      uint64_t size = 0;
+      for( const auto& fill : _recent_by_time )
+      {
+         const auto data = fc::raw::pack( get_record( *fill.market, *fill.part, fill.index ) );
+         out.write( data.data(), data.size() );
+         size += data.size();
+      }
+      for( auto& fill : _reversible )
+      {
+         const auto data = fc::raw::pack( fill.record );
+         fill.file_pos = size;
+         out.write( data.data(), data.size() );
+         size += data.size();
+      }
+      out.close();
+      FC_ASSERT( !out.fail(), "Unable to write ${f}", ("f",tmp_path) );
+      _file_size = size;
+   }
+   close();
+   fc::rename( tmp_path, _file_path );
+   _file.open( _file_path.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app );
+   FC_ASSERT( _file.is_open(), "Unable to open ${f}", ("f",_file_path) );
+}
+
+void fill_store::append_to_file( reversible_fill& fill )
+{
+   auto data = fc::raw::pack( fill.record );
+   fill.file_pos = _file_size;
+   _file.write( data.data(), data.size() );
+   _file_size += data.size();
+}
+
+void fill_store::push_block( uint32_t block_num, fc::time_point_sec time, const vector<fill_order_operation>& fills )
+{ try {
+   FC_ASSERT( is_open(), "The fill store is not open" );
+
+   if( !_reversible.empty() && _reversible.back().record.block_num >= block_num )
+   {
+      auto itr = std::find_if( _reversible.begin(), _reversible.end(), [block_num]( const reversible_fill& f ) {
+         return f.record.block_num >= block_num;
+      });
+      _file.close();
+      _file_size = itr->file_pos;
+      fc::resize_file( _file_path, _file_size );
+      _file.open( _file_path.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app );
+      FC_ASSERT( _file.is_open(), "Unable to open ${f}", ("f",_file_path) );
+      _reversible.erase( itr, _reversible.end() );
+   }
+
+   for( const auto& o : fills )
+   {
+      _reversible.emplace_back();
+      reversible_fill& fill = _reversible.back();
+      fill.record.block_num = block_num;
+      fill.record.time = time;
+      fill.record.op = o;
+      append_to_file( fill );
+   }
+   if( !fills.empty() )
+      _file.flush();
+} FC_CAPTURE_AND_RETHROW( (block_num)(time) ) }
+
+void fill_store::set_last_irreversible_block( uint32_t block_num )
+{
+   while( !_reversible.empty() && _reversible.front().record.block_num <= block_num )
+   {
+      add( _reversible.front().record );
+      _reversible.pop_front();
+   }
+   if( store_old_windows() )
+      rewrite_log();
+}
+
+void fill_store::add( const fill_record& record )
+{
+   const fill_order_operation& o = record.op;
+   const bool pays_base = ( o.pays.asset_id < o.receives.asset_id );
+   const market_key market = o.get_market();
+
+   const uint32_t t = record.time.sec_since_epoch();
+   const uint32_t start = t - t % _partition_seconds;
+   if( _windows.empty() || _windows.back().start < start )
+   {
+      _windows.emplace_back();
+      _windows.back().start = start;
+      _windows.back().first_block = record.block_num;
+   }
+   window& w = _windows.back();
+   FC_ASSERT( w.start == start, "Fills must be added in time order" );
+   w.last_block = record.block_num;
+
+   auto part_itr = w.markets.find( market );
+   if( part_itr == w.markets.end() )
+   {
+      part_itr = w.markets.emplace( market, partition() ).first;
+      part_itr->second.start = start;
+   }
+   partition& part = part_itr->second;
+   uint8_t flags = 0;
+   if( o.is_maker )
+      flags |= is_maker_flag;
+   if( pays_base )
+      flags |= pays_base_flag;
+   if( o.fill_price.base.asset_id == market.first )
+      flags |= fill_price_base_is_base_flag;
+
+   part.block_num.push_back( record.block_num );
+   part.time.push_back( t );
+   part.order_id.push_back( o.order_id.number );
+   part.account_id.push_back( o.account_id.instance.value );
+   part.pays_amount.push_back( o.pays.amount.value );
+   part.receives_amount.push_back( o.receives.amount.value );
+   part.fee_asset.push_back( o.fee.asset_id.instance.value );
+   part.fee_amount.push_back( o.fee.amount.value );
+   part.fill_price_base_amount.push_back( o.fill_price.base.amount.value );
+   part.fill_price_quote_amount.push_back( o.fill_price.quote.amount.value );
+   part.flags.push_back( flags );
+
+   recent_fill fill;
+   fill.time = t;
+   fill.index = uint32_t( part.size() - 1 );
+   fill.market = &part_itr->first;
+   fill.part = &part;
+   _recent_by_time.push_back( fill );
+   ++_markets[market].count;
+   ++_size;
+}
+
+bool fill_store::store_old_windows()
+{
+   if( _recent_by_time.empty() )
+      return false;
+   const uint64_t newest = _recent_by_time.back().time;
+
+   bool stored = false;
+   while( !_windows.empty() && uint64_t( _windows.front().start ) + _partition_seconds + _recent_seconds <= newest )
+   {
+      const window& w = _windows.front();
+      detail::stored_window_header header;
+      header.start = w.start;
+      header.first_block = w.first_block;
+      header.last_block = w.last_block;
+      vector<char> body;
+      for( const auto& item : w.markets )
+      {
+         const auto data = fc::raw::pack( item.second );
+         header.partitions.emplace_back();
+         detail::stored_partition_location& location = header.partitions.back();
+         location.base = item.first.first;
+         location.quote = item.first.second;
+         location.count = item.second.size();
+         location.offset = body.size();
+         location.size = data.size();
+         body.insert( body.end(), data.begin(), data.end() );
+      }
+      const auto header_data = fc::raw::pack( header );
+      const uint64_t sizes[2] = { header_data.size(), body.size() };
+
+      std::ofstream out( _stored_path.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app );
+      FC_ASSERT( out.is_open(), "Unable to open ${f}", ("f",_stored_path) );
+      out.write( reinterpret_cast<const char*>( sizes ), sizeof(sizes) );
+      out.write( header_data.data(), header_data.size() );
+      out.write( body.data(), body.size() );
+      out.close();
+      FC_ASSERT( !out.fail(), "Unable to write ${f}", ("f",_stored_path) );
+
+      // the counts of the markets and the store do not change, the fills only move
+      const uint64_t body_pos = _stored_size + sizeof(sizes) + header_data.size();
+      for( const auto& location : header.partitions )
+      {
+         market_fills& fills = _markets[ market_key( location.base, location.quote ) ];
+         fills.stored.emplace_back();
+         stored_partition& part = fills.stored.back();
+         part.start = header.start;
+         part.count = location.count;
+         part.pos = body_pos + location.offset;
+         part.size = location.size;
+      }
+      _stored_size = body_pos + body.size();
+
+      const uint64_t end = uint64_t( w.start ) + _partition_seconds;
+      while( !_recent_by_time.empty() && _recent_by_time.front().time < end )
+         _recent_by_time.pop_front();
+      _windows.pop_front();
+      stored = true;
+   }
+   return stored;
+}
+
+fill_store::partition fill_store::load_partition( const stored_partition& location )const
+{ try {
+   std::ifstream in( _stored_path.generic_string().c_str(), std::ios::in | std::ios::binary );
+   FC_ASSERT( in.is_open(), "Unable to open ${f}", ("f",_stored_path) );
+   vector<char> data( location.size );
+   in.seekg( location.pos );
+   in.read( data.data(), data.size() );
+   FC_ASSERT( size_t( in.gcount() ) == data.size(), "Unable to read ${f}", ("f",_stored_path) );
+   return fc::raw::unpack<partition>( data );
+} FC_CAPTURE_AND_RETHROW( (location.start)(location.pos)(location.size) ) }
+
+fill_order_operation fill_store::get_fill( const market_key& market, const partition& part, size_t i )const
+{
+   fill_order_operation o;
+   const uint8_t flags = part.flags[i];
+   const asset_id_type pays_asset = ( flags & pays_base_flag ) ? market.first : market.second;
+   const asset_id_type receives_asset = ( flags & pays_base_flag ) ? market.second : market.first;
+   const asset_id_type price_base_asset = ( flags & fill_price_base_is_base_flag ) ? market.first : market.second;
+   const asset_id_type price_quote_asset = ( flags & fill_price_base_is_base_flag ) ? market.second : market.first;
+
+   o.order_id.number = part.order_id[i];
+   o.account_id = account_id_type( part.account_id[i] );
+   o.pays = asset( part.pays_amount[i], pays_asset );
+   o.receives = asset( part.receives_amount[i], receives_asset );
+   o.fee = asset( part.fee_amount[i], asset_id_type( part.fee_asset[i] ) );
+   o.fill_price = price( asset( part.fill_price_base_amount[i], price_base_asset ),
+                         asset( part.fill_price_quote_amount[i], price_quote_asset ) );
+   o.is_maker = ( flags & is_maker_flag );
+   return o;
+}
+
+fill_record fill_store::get_record( const market_key& market, const partition& part, size_t i )const
+{
+   fill_record record;
+   record.block_num = part.block_num[i];
+   record.time = fc::time_point_sec( part.time[i] );
+   record.op = get_fill( market, part, i );
+   return record;
+}
+
+void fill_store::for_each_fill_in(
+      const market_key& market, const partition& part, uint32_t start_sec, uint32_t end_sec,
+      const std::function<void(fc::time_point_sec, const fill_order_operation&)>& f )const
+{
+   auto begin = std::lower_bound( part.time.begin(), part.time.end(), start_sec );
+   for( size_t i = begin - part.time.begin(); i < part.size() && part.time[i] < end_sec; ++i )
+      f( fc::time_point_sec( part.time[i] ), get_fill( market, part, i ) );
+}
+
+std::deque< fill_store::reversible_fill >::const_iterator fill_store::first_reversible( uint32_t start_sec )const
+{
+   return std::lower_bound( _reversible.begin(), _reversible.end(), start_sec,
+                            []( const reversible_fill& f, uint32_t s ) {
+                               return f.record.time.sec_since_epoch() < s;
+                            });
+}
+
+void fill_store::for_each_fill( const market_key& market, fc::time_point_sec start, fc::time_point_sec end,
+                                const std::function<void(fc::time_point_sec, const fill_order_operation&)>& f )const
+{
+   const uint32_t start_sec = start.sec_since_epoch();
+   const uint32_t end_sec = end.sec_since_epoch();
+
+   auto market_itr = _markets.find( market );
+   if( market_itr != _markets.end() )
+   {
+      const auto& stored = market_itr->second.stored;
+      // skip windows which end before start
+      auto itr = std::lower_bound( stored.begin(), stored.end(), start_sec,
+                                   [this]( const stored_partition& p, uint32_t s ) {
+                                      return uint64_t(p.start) + _partition_seconds <= s;
+                                   });
+      for( ; itr != stored.end() && itr->start < end_sec; ++itr )
+         for_each_fill_in( market, load_partition( *itr ), start_sec, end_sec, f );
+   }
+
+   for( const auto& w : _windows )
+   {
+      if( uint64_t(w.start) + _partition_seconds <= start_sec )
+         continue;
+      if( w.start >= end_sec )
+         break;
+      auto part_itr = w.markets.find( market );
+      if( part_itr != w.markets.end() )
+         for_each_fill_in( market, part_itr->second, start_sec, end_sec, f );
+   }
+
+   for( auto itr = first_reversible( start_sec ); itr != _reversible.end(); ++itr )
+   {
+      if( itr->record.time.sec_since_epoch() >= end_sec )
+         break;
+      if( itr->record.op.get_market() == market )
+         f( itr->record.time, itr->record.op );
+   }
+}
+
+void fill_store::for_each_fill( fc::time_point_sec start, fc::time_point_sec end,
+                                const std::function<void(fc::time_point_sec, const fill_order_operation&)>& f )const
+{
+   const uint32_t start_sec = start.sec_since_epoch();
+   const uint32_t end_sec = end.sec_since_epoch();
+
+   // stored windows are only read when the range reaches back before the recent ones
+   const uint32_t recent_start = _windows.empty() ? std::numeric_limits<uint32_t>::max() : _windows.front().start;
+   if( start_sec < recent_start && _stored_size > 0 )
+   {
+      const uint32_t stored_end = std::min( end_sec, recent_start );
+      for( const auto& item : _markets )
+      {
+         const auto& stored = item.second.stored;
+         auto itr = std::lower_bound( stored.begin(), stored.end(), start_sec,
+                                      [this]( const stored_partition& p, uint32_t s ) {
+                                         return uint64_t(p.start) + _partition_seconds <= s;
+                                      });
+         for( ; itr != stored.end() && itr->start < stored_end; ++itr )
+            for_each_fill_in( item.first, load_partition( *itr ), start_sec, stored_end, f );
+      }
+   }
+
+   auto itr = std::lower_bound( _recent_by_time.begin(), _recent_by_time.end(), start_sec,
+                                []( const recent_fill& fill, uint32_t s ) { return fill.time < s; } );
+   for( ; itr != _recent_by_time.end() && itr->time < end_sec; ++itr )
+      f( fc::time_point_sec( itr->time ), get_fill( *itr->market, *itr->part, itr->index ) );
+
+   // reversible fills are newer than the permanent ones
+   for( auto rev_itr = first_reversible( start_sec ); rev_itr != _reversible.end(); ++rev_itr )
+   {
+      if( rev_itr->record.time.sec_since_epoch() >= end_sec )
+         break;
+      f( rev_itr->record.time, rev_itr->record.op );
+   }
+}
+
+vector<bucket_object> fill_store::get_buckets( asset_id_type base, asset_id_type quote, uint32_t bucket_seconds,
+                                               fc::time_point_sec start, fc::time_point_sec end,
+                                               uint32_t limit )const
+{ try {
+   FC_ASSERT( bucket_seconds > 0, "bucket_seconds must be positive" );
+
+   vector<bucket_object> result;
+   if( base > quote )
+      std::swap( base, quote );
+   if( limit == 0 || start > end )
+      return result;
+
+   // fills in buckets with open time in [start,end]
+   const uint64_t first_open = ( uint64_t(start.sec_since_epoch()) + bucket_seconds - 1 )
+                               / bucket_seconds * bucket_seconds;
+   const uint64_t last_open = end.sec_since_epoch() / bucket_seconds * bucket_seconds;
+   if( first_open > last_open )
+      return result;
+   const uint64_t fills_end = std::min<uint64_t>( last_open + bucket_seconds,
+                                                  fc::time_point_sec::maximum().sec_since_epoch() );
+
+   const market_key market( base, quote );
+   bool done = false;
+   for_each_fill( market, fc::time_point_sec( uint32_t(first_open) ), fc::time_point_sec( uint32_t(fills_end) ),
+                  [&]( fc::time_point_sec time, const fill_order_operation& o ) {
+      if( done || !o.is_maker )
+         return;
+
+      price trade_price = o.pays / o.receives;
+      if( o.pays.asset_id > o.receives.asset_id )
+         trade_price = ~trade_price;
+      price fill_price = o.fill_price;
+      if( fill_price.base.asset_id > fill_price.quote.asset_id )
+         fill_price = ~fill_price;
+
+      const fc::time_point_sec open( time.sec_since_epoch() / bucket_seconds * bucket_seconds );
+      if( result.empty() || result.back().key.open != open )
+      {
+         if( result.size() >= limit )
+         {
+            done = true;
+            return;
+         }
+         result.emplace_back();
+         bucket_object& b = result.back();
+         b.key = bucket_key( base, quote, bucket_seconds, open );
+         b.base_volume = trade_price.base.amount;
+         b.quote_volume = trade_price.quote.amount;
+         b.open_base = fill_price.base.amount;
+         b.open_quote = fill_price.quote.amount;
+         b.close_base = fill_price.base.amount;
+         b.close_quote = fill_price.quote.amount;
+         b.high_base = b.close_base;
+         b.high_quote = b.close_quote;
+         b.low_base = b.close_base;
+         b.low_quote = b.close_quote;
+         return;
+      }
+
+      bucket_object& b = result.back();
+      try {
+         b.base_volume += trade_price.base.amount;
+      } catch( fc::overflow_exception& ) {
+         b.base_volume = std::numeric_limits<int64_t>::max();
+      }
+      try {
+         b.quote_volume += trade_price.quote.amount;
+      } catch( fc::overflow_exception& ) {
+         b.quote_volume = std::numeric_limits<int64_t>::max();
+      }
+      b.close_base = fill_price.base.amount;
+      b.close_quote = fill_price.quote.amount;
+      if( b.high() < fill_price )
+      {
+         b.high_base = b.close_base;
+         b.high_quote = b.close_quote;
+      }
+      if( b.low() > fill_price )
+      {
+         b.low_base = b.close_base;
+         b.low_quote = b.close_quote;
+      }
+   });
+   return result;
+} FC_CAPTURE_AND_RETHROW( (base)(quote)(bucket_seconds)(start)(end)(limit) ) }
+
+vector<order_history_object> fill_store::get_fills( asset_id_type base, asset_id_type quote, uint32_t limit,
+                                                    fc::time_point_sec start, fc::time_point_sec stop,
+                                                    int64_t first_sequence )const
+{
+   vector<order_history_object> result;
+   if( base > quote )
+      std::swap( base, quote );
+   const market_key market( base, quote );
+   const uint32_t start_sec = start.sec_since_epoch();
+   const uint32_t stop_sec = stop.sec_since_epoch();
+
+   // the oldest fill of the market has sequence 0, newer ones have smaller sequences, like in history_index
+   int64_t sequence = 0;
+   auto market_itr = _markets.find( market );
+   if( market_itr != _markets.end() )
+      sequence -= market_itr->second.count;
+   for( const auto& fill : _reversible )
+   {
+      if( fill.record.op.get_market() == market )
+         --sequence;
+   }
+
+   bool done = ( limit == 0 );
+   auto add_result = [&]( fc::time_point_sec time, const fill_order_operation& o ) {
+      ++sequence;
+      if( sequence < first_sequence || time > start )
+         return;
+      if( time < stop )
+      {
+         done = true;
+         return;
+      }
+      result.emplace_back();
+      order_history_object& h = result.back();
+      h.key.base = base;
+      h.key.quote = quote;
+      h.key.sequence = sequence;
+      h.time = time;
+      h.op = o;
+      done = ( result.size() >= limit );
+   };
+   // skips partitions which are too new entirely, stops at partitions which are too old
+   auto wanted = [&]( uint32_t part_start, uint32_t count ) {
+      if( part_start > start_sec || sequence + int64_t(count) < first_sequence )
+      {
+         sequence += count;
+         return false;
+      }
+      if( uint64_t(part_start) + _partition_seconds <= stop_sec )
+      {
+         done = true;
+         return false;
+      }
+      return true;
+   };
+   auto add_partition = [&]( const partition& part ) {
+      for( size_t i = part.size(); i > 0 && !done; --i )
+         add_result( fc::time_point_sec( part.time[i-1] ), get_fill( market, part, i-1 ) );
+   };
+
+   for( auto itr = _reversible.rbegin(); itr != _reversible.rend() && !done; ++itr )
+   {
+      if( itr->record.op.get_market() == market )
+         add_result( itr->record.time, itr->record.op );
+   }
+   for( auto itr = _windows.rbegin(); itr != _windows.rend() && !done; ++itr )
+   {
+      auto part_itr = itr->markets.find( market );
+      if( part_itr != itr->markets.end() && wanted( itr->start, part_itr->second.size() ) )
+         add_partition( part_itr->second );
+   }
+   if( market_itr != _markets.end() )
+   {
+      const auto& stored = market_itr->second.stored;
+      for( auto itr = stored.rbegin(); itr != stored.rend() && !done; ++itr )
+      {
+         if( wanted( itr->start, itr->count ) )
+            add_partition( load_partition( *itr ) );
+      }
+   }
+   return result;
+}
+
+} } // graphene::market_history
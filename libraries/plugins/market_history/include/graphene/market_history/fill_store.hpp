@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/market_history/market_history_plugin.hpp>
+
+#include <fc/filesystem.hpp>
+
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+
+namespace graphene { namespace market_history {
+
+/// A filled order as it is kept in the fill store
+struct fill_record
+{
+   uint32_t             block_num = 0;
+   fc::time_point_sec   time;
+   fill_order_operation op;
+};
+
+namespace detail {
+
+   /// Fills of one market in one time window, one vector per field
+   struct fill_partition
+   {
+      uint32_t            start = 0;
+      vector<uint32_t>    block_num;
+      vector<uint32_t>    time;
+      vector<uint64_t>    order_id;
+      vector<uint64_t>    account_id;
+      vector<int64_t>     pays_amount;
+      vector<int64_t>     receives_amount;
+      vector<uint64_t>    fee_asset;
+      vector<int64_t>     fee_amount;
+      vector<int64_t>     fill_price_base_amount;
+      vector<int64_t>     fill_price_quote_amount;
+      /// @see fill_store::flag_bits
+      vector<uint8_t>     flags;
+
+      size_t size()const { return time.size(); }
+   };
+
+   /// Where the partition of a market is in the body of a stored window
+   struct stored_partition_location
+   {
+      asset_id_type  base;
+      asset_id_type  quote;
+      uint32_t       count = 0;
+      uint64_t       offset = 0;
+      uint64_t       size = 0;
+   };
+
+   /// Header of a time window in the file of stored windows
+   struct stored_window_header
+   {
+      uint32_t                           start = 0;
+      uint32_t                           first_block = 0;
+      uint32_t                           last_block = 0;
+      vector<stored_partition_location>  partitions;
+   };
+
+} // detail
+
+/**
+ *  @brief Stores filled orders once per market in a compact, append-only, time-partitioned columnar layout.
+ *
+ *  OHLCV buckets of any size are rolled up from the fills at query time, so that adding bucket sizes costs
+ *  nothing on block application and years of history can be kept.
+ *
+ *  Fills are grouped in time windows. Only the fills of recent windows are kept in memory, where they are also
+ *  indexed by time across markets, so that visiting the fills of a time range, e.g. to roll them out of the
+ *  24h ticker, costs nothing per market. Older windows are appended to a file of stored windows, only the
+ *  locations of their partitions stay in memory, and they are read back by market when a query reaches them.
+ *
+ *  Every fill is appended to a log file on disk as soon as its block is pushed. Fills of blocks that may still be
+ *  reverted are kept aside until the blocks become irreversible, only then they are added to the columns.
+ *  When blocks are reverted, their fills are dropped and the log is truncated accordingly. The log only holds
+ *  the fills of the recent windows and the reversible ones, it is rewritten when windows are stored.
+ */
+class fill_store
+{
+   public:
+      /**
+       * @param partition_seconds length of the time windows
+       * @param recent_seconds windows which end less than this before the newest permanent fill are kept
+       *                       in memory
+       */
+      explicit fill_store( uint32_t partition_seconds = 86400, uint32_t recent_seconds = 86400 );
+      ~fill_store();
+
+      /**
+       * Loads the fills stored in directory @p dir. Stored fills of blocks @p first_new_block and later are
+       * dropped, they will be pushed again.
+       */
+      void open( const fc::path& dir, uint32_t first_new_block );
+      bool is_open()const { return _file.is_open(); }
+      void close();
+
+      /**
+       * Adds the fills of a block that may still be reverted. Fills of blocks @p block_num and later which were
+       * pushed before are dropped, since their blocks have been reverted.
+       */
+      void push_block( uint32_t block_num, fc::time_point_sec time, const vector<fill_order_operation>& fills );
+      /// Moves fills of blocks up to @p block_num to permanent storage
+      void set_last_irreversible_block( uint32_t block_num );
+
+      /// Rolls up maker fills into buckets of @p bucket_seconds, with bucket open times in [start,end]
+      vector<bucket_object> get_buckets( asset_id_type base, asset_id_type quote, uint32_t bucket_seconds,
+                                         fc::time_point_sec start, fc::time_point_sec end,
+                                         uint32_t limit )const;
+      /**
+       * @return the most recent fills in a market with time in [@p stop, @p start] and sequence @p first_sequence
+       *         or greater, newest first. Sequences are numbered like in history_index.
+       */
+      vector<order_history_object> get_fills( asset_id_type base, asset_id_type quote, uint32_t limit,
+                                              fc::time_point_sec start = fc::time_point_sec::maximum(),
+                                              fc::time_point_sec stop = fc::time_point_sec(),
+                                              int64_t first_sequence = std::numeric_limits<int64_t>::min() )const;
+      /// Visits the fills of all markets with time in [start,end), oldest first in each market
+      void for_each_fill( fc::time_point_sec start, fc::time_point_sec end,
+                          const std::function<void(fc::time_point_sec, const fill_order_operation&)>& f )const;
+
+      /// @return the number of fills in permanent storage
+      uint64_t size()const { return _size; }
+      /// @return the number of fills in permanent storage which are kept in memory
+      uint64_t recent_size()const { return _recent_by_time.size(); }
+
+   private:
+      using partition = detail::fill_partition;
+      enum flag_bits : uint8_t
+      {
+         is_maker_flag = 1,
+         pays_base_flag = 2,
+         fill_price_base_is_base_flag = 4
+      };
+      using market_key = std::pair<asset_id_type, asset_id_type>;
+      /// Where the fills of a market in a stored window are in the file of stored windows
+      struct stored_partition
+      {
+         uint32_t start = 0;
+         uint32_t count = 0;
+         uint64_t pos = 0;
+         uint64_t size = 0;
+      };
+      struct market_fills
+      {
+         /// Oldest first
+         vector<stored_partition> stored;
+         /// Number of fills in permanent storage, stored or recent
+         uint64_t                 count = 0;
+      };
+      /// The fills of all markets in a recent time window
+      struct window
+      {
+         uint32_t                          start = 0;
+         uint32_t                          first_block = 0;
+         uint32_t                          last_block = 0;
+         std::map< market_key, partition > markets;
+      };
+      /// A fill of a recent window
+      struct recent_fill
+      {
+         uint32_t          time = 0;
+         uint32_t          index = 0;
+         const market_key* market = nullptr;
+         const partition*  part = nullptr;
+      };
+      struct reversible_fill
+      {
+         fill_record record;
+         /// Position of the record in the log
+         uint64_t    file_pos = 0;
+      };
+
+      void add( const fill_record& record );
+      fill_order_operation get_fill( const market_key& market, const partition& part, size_t i )const;
+      fill_record get_record( const market_key& market, const partition& part, size_t i )const;
+      void append_to_file( reversible_fill& fill );
+      /// Reads the log, keeping fills of blocks before @p first_new_block which are not in a stored window
+      void read_log( uint32_t first_new_block, uint32_t stored_until );
+      /// Writes the fills of the recent windows and the reversible fills to a new log
+      void rewrite_log();
+      /**
+       * Registers the stored windows. Windows with fills of blocks @p first_new_block and later are removed from
+       * the file, their fills of earlier blocks are added to @p reopened.
+       * @return the end of the last window that was stored
+       */
+      uint32_t load_stored_windows( uint32_t first_new_block, vector<fill_record>& reopened );
+      void register_stored_window( const detail::stored_window_header& header, uint64_t body_pos );
+      /// Moves windows which are no longer recent to the file of stored windows, @return whether any was
+      bool store_old_windows();
+      partition load_partition( const stored_partition& location )const;
+      /// Visits the fills of the market with time in [start,end), oldest first, including reversible ones
+      void for_each_fill( const market_key& market, fc::time_point_sec start, fc::time_point_sec end,
+                          const std::function<void(fc::time_point_sec, const fill_order_operation&)>& f )const;
+      /// Visits the fills of a partition with time in [start,end), oldest first
+      void for_each_fill_in( const market_key& market, const partition& part, uint32_t start_sec, uint32_t end_sec,
+                             const std::function<void(fc::time_point_sec, const fill_order_operation&)>& f )const;
+      /// @return the first reversible fill with time @p start_sec or later
+      std::deque< reversible_fill >::const_iterator first_reversible( uint32_t start_sec )const;
+
+      const uint32_t                                    _partition_seconds;
+      const uint32_t                                    _recent_seconds;
+      std::map< market_key, market_fills >              _markets;
+      /// Recent windows, oldest first
+      std::deque< window >                              _windows;
+      /// The fills of the recent windows in time order across markets
+      std::deque< recent_fill >                         _recent_by_time;
+      std::deque< reversible_fill >                     _reversible;
+      uint64_t                                          _size = 0;
+      fc::path                                          _file_path;
+      uint64_t                                          _file_size = 0;
+      std::ofstream                                     _file;
+      fc::path                                          _stored_path;
+      uint64_t                                          _stored_size = 0;
+};
+
+} } // graphene::market_history
+
+FC_REFLECT( graphene::market_history::fill_record, (block_num)(time)(op) )
+FC_REFLECT( graphene::market_history::detail::fill_partition,
+            (start)(block_num)(time)(order_id)(account_id)(pays_amount)(receives_amount)(fee_asset)(fee_amount)
+            (fill_price_base_amount)(fill_price_quote_amount)(flags) )
+FC_REFLECT( graphene::market_history::detail::stored_partition_location, (base)(quote)(count)(offset)(size) )
+FC_REFLECT( graphene::market_history::detail::stored_window_header, (start)(first_block)(last_block)(partitions) )
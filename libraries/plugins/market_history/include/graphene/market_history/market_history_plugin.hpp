@@ -377,6 +377,8 @@ namespace detail
  *  will scan the virtual operations and look for fill_order_operations and then adjust the appropriate bucket objects for
  *  each fill order.
  */
+class fill_store;
+
 class market_history_plugin : public graphene::app::plugin
 {
    public:
@@ -395,6 +397,8 @@ class market_history_plugin : public graphene::app::plugin
       const flat_set<uint32_t>&   tracked_buckets()const;
       uint32_t                    max_order_his_records_per_market()const;
       uint32_t                    max_order_his_seconds_per_market()const;
+      /// @return the columnar fill store if it is enabled, otherwise nullptr
+      const fill_store*           get_fill_store()const;
 
    private:
       std::unique_ptr<detail::market_history_plugin_impl> my;
@@ -23,6 +23,7 @@
  */
 
 #include <graphene/market_history/market_history_plugin.hpp>
+#include <graphene/market_history/fill_store.hpp>
 
 #include <graphene/chain/account_evaluator.hpp>
 #include <graphene/chain/account_object.hpp>
@@ -51,6 +52,11 @@ class market_history_plugin_impl
        */
       void update_market_histories( const signed_block& b );
 
+      /// subtract a fill which is older than a day from the ticker of its market
+      void roll_out_of_ticker( const fill_order_operation& o );
+      /// roll out fills kept in the fill store which became older than a day since the previous block
+      void roll_out_stored_fills_of_ticker( const signed_block& b );
+
       /// process all operations related to liquidity pools
       void update_liquidity_pool_histories( time_point_sec time, const operation_history_object& oho,
                                             const liquidity_pool_ticker_meta_object*& lp_meta );
@@ -65,6 +71,12 @@ class market_history_plugin_impl
       uint32_t                   _maximum_history_per_bucket_size = 1000;
       uint32_t                   _max_order_his_records_per_market = 1000;
       uint32_t                   _max_order_his_seconds_per_market = 259200;
+      /// If set, fills are kept here and buckets are rolled up from them, instead of tracking bucket objects
+      /// and order history objects
+      std::unique_ptr<fill_store> _fill_store;
+      /// Number and time of the last processed block, to find the fills rolled out of the ticker by the next block
+      uint32_t                    _last_block_num = 0;
+      fc::time_point_sec          _last_block_time;
 };
 
 
@@ -87,77 +99,10 @@ struct operation_process_fill_order
    {
       //ilog( "processing ${o}", ("o",o) );
       auto& db         = _plugin.database();
-      const auto& order_his_idx = db.get_index_type<history_index>().indices();
-      const auto& history_idx = order_his_idx.get<by_key>();
-      const auto& his_time_idx = order_his_idx.get<by_market_time>();
-
-      // To save new filled order data
-      history_key hkey;
-      hkey.base = o.pays.asset_id;
-      hkey.quote = o.receives.asset_id;
-      if( hkey.base > hkey.quote )
-         std::swap( hkey.base, hkey.quote );
-      hkey.sequence = std::numeric_limits<int64_t>::min();
-
-      auto itr = history_idx.lower_bound( hkey );
-
-      if( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
-         hkey.sequence = itr->key.sequence - 1;
-      else
-         hkey.sequence = 0;
 
-      const auto& new_order_his_obj = db.create<order_history_object>( [&]( order_history_object& ho ) {
-         ho.key = hkey;
-         ho.time = _now;
-         ho.op = o;
-      });
-
-      // save a reference to market ticker meta object
-      if( _meta == nullptr )
-      {
-         const auto& meta_idx = db.get_index_type<simple_index<market_ticker_meta_object>>();
-         if( meta_idx.size() == 0 )
-            _meta = &db.create<market_ticker_meta_object>( [&]( market_ticker_meta_object& mtm ) {
-               mtm.rolling_min_order_his_id = new_order_his_obj.id;
-               mtm.skip_min_order_his_id = false;
-            });
-         else
-            _meta = &( *meta_idx.begin() );
-      }
-
-      // To remove old filled order data
-      const auto max_records = _plugin.max_order_his_records_per_market();
-      hkey.sequence += max_records;
-      itr = history_idx.lower_bound( hkey );
-      if( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
-      {
-         const auto max_seconds = _plugin.max_order_his_seconds_per_market();
-         fc::time_point_sec min_time;
-         if( min_time + max_seconds < _now )
-            min_time = _now - max_seconds;
-         auto time_itr = his_time_idx.lower_bound( std::make_tuple( hkey.base, hkey.quote, min_time ) );
-         if( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
-         {
-            if( itr->key.sequence >= time_itr->key.sequence )
-            {
-               while( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
-               {
-                  auto old_itr = itr;
-                  ++itr;
-                  db.remove( *old_itr );
-               }
-            }
-            else
-            {
-               while( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
-               {
-                  auto old_itr = time_itr;
-                  ++time_itr;
-                  db.remove( *old_itr );
-               }
-            }
-         }
-      }
+      // To save new filled order data, unless fills are kept in the fill store
+      if( _plugin.get_fill_store() == nullptr )
+         update_order_history( o );
 
       // To update ticker data and buckets data, only update for maker orders
       if( !o.is_maker )
@@ -205,7 +150,9 @@ struct operation_process_fill_order
          });
       }
 
-      // To update buckets data
+      // To update buckets data, unless buckets are rolled up from the fill store
+      if( _plugin.get_fill_store() != nullptr ) return;
+
       const auto max_history = _plugin.max_history();
       if( max_history == 0 ) return;
 
@@ -291,8 +238,143 @@ struct operation_process_fill_order
           }
       }
    }
+
+   void update_order_history( const fill_order_operation& o )const
+   {
+      auto& db         = _plugin.database();
+      const auto& order_his_idx = db.get_index_type<history_index>().indices();
+      const auto& history_idx = order_his_idx.get<by_key>();
+      const auto& his_time_idx = order_his_idx.get<by_market_time>();
+
+      history_key hkey;
+      hkey.base = o.pays.asset_id;
+      hkey.quote = o.receives.asset_id;
+      if( hkey.base > hkey.quote )
+         std::swap( hkey.base, hkey.quote );
+      hkey.sequence = std::numeric_limits<int64_t>::min();
+
+      auto itr = history_idx.lower_bound( hkey );
+
+      if( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
+         hkey.sequence = itr->key.sequence - 1;
+      else
+         hkey.sequence = 0;
+
+      const auto& new_order_his_obj = db.create<order_history_object>( [&]( order_history_object& ho ) {
+         ho.key = hkey;
+         ho.time = _now;
+         ho.op = o;
+      });
+
+      // save a reference to market ticker meta object
+      if( _meta == nullptr )
+      {
+         const auto& meta_idx = db.get_index_type<simple_index<market_ticker_meta_object>>();
+         if( meta_idx.size() == 0 )
+            _meta = &db.create<market_ticker_meta_object>( [&]( market_ticker_meta_object& mtm ) {
+               mtm.rolling_min_order_his_id = new_order_his_obj.id;
+               mtm.skip_min_order_his_id = false;
+            });
+         else
+            _meta = &( *meta_idx.begin() );
+      }
+
+      // To remove old filled order data
+      const auto max_records = _plugin.max_order_his_records_per_market();
+      hkey.sequence += max_records;
+      itr = history_idx.lower_bound( hkey );
+      if( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
+      {
+         const auto max_seconds = _plugin.max_order_his_seconds_per_market();
+         fc::time_point_sec min_time;
+         if( min_time + max_seconds < _now )
+            min_time = _now - max_seconds;
+         auto time_itr = his_time_idx.lower_bound( std::make_tuple( hkey.base, hkey.quote, min_time ) );
+         if( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
+         {
+            if( itr->key.sequence >= time_itr->key.sequence )
+            {
+               while( itr != history_idx.end() && itr->key.base == hkey.base && itr->key.quote == hkey.quote )
+               {
+                  auto old_itr = itr;
+                  ++itr;
+                  db.remove( *old_itr );
+               }
+            }
+            else
+            {
+               while( time_itr != his_time_idx.end() && time_itr->key.base == hkey.base && time_itr->key.quote == hkey.quote )
+               {
+                  auto old_itr = time_itr;
+                  ++time_itr;
+                  db.remove( *old_itr );
+               }
+            }
+         }
+      }
+   }
 };
 
+void market_history_plugin_impl::roll_out_of_ticker( const fill_order_operation& o )
+{
+   graphene::chain::database& db = database();
+
+   bucket_key key;
+   key.base    = o.pays.asset_id;
+   key.quote   = o.receives.asset_id;
+
+   price trade_price = o.pays / o.receives;
+
+   if( key.base > key.quote )
+   {
+      std::swap( key.base, key.quote );
+      trade_price = ~trade_price;
+   }
+
+   price fill_price = o.fill_price;
+   if( fill_price.base.asset_id > fill_price.quote.asset_id )
+      fill_price = ~fill_price;
+
+   const auto& ticker_idx = db.get_index_type<market_ticker_index>().indices().get<by_market>();
+   auto ticker_itr = ticker_idx.find( std::make_tuple( key.base, key.quote ) );
+   if( ticker_itr != ticker_idx.end() ) // should always be true
+   {
+      db.modify( *ticker_itr, [&]( market_ticker_object& mt ) {
+         mt.last_day_base  = fill_price.base.amount;
+         mt.last_day_quote = fill_price.quote.amount;
+         mt.base_volume    -= trade_price.base.amount.value;  // ignore underflow
+         mt.quote_volume   -= trade_price.quote.amount.value; // ignore underflow
+      });
+   }
+}
+
+void market_history_plugin_impl::roll_out_stored_fills_of_ticker( const signed_block& b )
+{
+   graphene::chain::database& db = database();
+
+   // The previous block is usually the last processed one, but not after a restart or when blocks were popped
+   fc::time_point_sec previous_time = b.timestamp;
+   if( _last_block_num + 1 == b.block_num() )
+      previous_time = _last_block_time;
+   else if( b.block_num() > 1 )
+   {
+      auto previous_block = db.fetch_block_by_number( b.block_num() - 1 );
+      if( previous_block.valid() )
+         previous_time = previous_block->timestamp;
+   }
+   _last_block_num = b.block_num();
+   _last_block_time = b.timestamp;
+
+   if( previous_time.sec_since_epoch() <= 86400 || previous_time >= b.timestamp )
+      return;
+
+   _fill_store->for_each_fill( previous_time - 86400, b.timestamp - 86400,
+                               [this]( fc::time_point_sec, const fill_order_operation& o ) {
+      if( o.is_maker )
+         roll_out_of_ticker( o );
+   });
+}
+
 void market_history_plugin_impl::update_market_histories( const signed_block& b )
 {
    graphene::chain::database& db = database();
@@ -307,6 +389,8 @@ void market_history_plugin_impl::update_market_histories( const signed_block& b
    if( lp_meta_idx.size() > 0 )
       _lp_meta = &( *lp_meta_idx.begin() );
 
+   vector<fill_order_operation> fills;
+
    const vector<optional< operation_history_object > >& hist = db.get_applied_operations();
    for( const optional< operation_history_object >& o_op : hist )
    {
@@ -317,54 +401,36 @@ void market_history_plugin_impl::update_market_histories( const signed_block& b
          {
             o_op->op.visit( operation_process_fill_order( _self, b.timestamp, _meta ) );
          } FC_CAPTURE_AND_LOG( (o_op) )
+         if( _fill_store && o_op->op.is_type<fill_order_operation>() )
+            fills.push_back( o_op->op.get<fill_order_operation>() );
          // process liquidity pool history
          update_liquidity_pool_histories( b.timestamp, *o_op, _lp_meta );
       }
    }
-   // roll out expired data from ticker
+   if( _fill_store )
+   {
+      if( !_fill_store->is_open() )
+         _fill_store->open( db.get_data_dir() / "market_history", b.block_num() );
+      _fill_store->push_block( b.block_num(), b.timestamp, fills );
+      _fill_store->set_last_irreversible_block( db.get_dynamic_global_properties().last_irreversible_block_num );
+      roll_out_stored_fills_of_ticker( b );
+   }
+   // roll out expired data from ticker.
+   // Note: with the fill store, this only rolls out order history objects created before the store was enabled
    if( _meta != nullptr )
    {
       time_point_sec last_day = b.timestamp - 86400;
       object_id_type last_min_his_id = _meta->rolling_min_order_his_id;
       bool skip = _meta->skip_min_order_his_id;
 
-      const auto& ticker_idx = db.get_index_type<market_ticker_index>().indices().get<by_market>();
       const auto& history_idx = db.get_index_type<history_index>().indices().get<by_id>();
       auto history_itr = history_idx.lower_bound( _meta->rolling_min_order_his_id );
       while( history_itr != history_idx.end() && history_itr->time < last_day )
       {
-         const fill_order_operation& o = history_itr->op;
          if( skip && history_itr->id == _meta->rolling_min_order_his_id )
             skip = false;
-         else if( o.is_maker )
-         {
-            bucket_key key;
-            key.base    = o.pays.asset_id;
-            key.quote   = o.receives.asset_id;
-
-            price trade_price = o.pays / o.receives;
-
-            if( key.base > key.quote )
-            {
-               std::swap( key.base, key.quote );
-               trade_price = ~trade_price;
-            }
-
-            price fill_price = o.fill_price;
-            if( fill_price.base.asset_id > fill_price.quote.asset_id )
-               fill_price = ~fill_price;
-
-            auto ticker_itr = ticker_idx.find( std::make_tuple( key.base, key.quote ) );
-            if( ticker_itr != ticker_idx.end() ) // should always be true
-            {
-               db.modify( *ticker_itr, [&]( market_ticker_object& mt ) {
-                  mt.last_day_base  = fill_price.base.amount;
-                  mt.last_day_quote = fill_price.quote.amount;
-                  mt.base_volume    -= trade_price.base.amount.value;  // ignore underflow
-                  mt.quote_volume   -= trade_price.quote.amount.value; // ignore underflow
-               });
-            }
-         }
+         else if( history_itr->op.is_maker )
+            roll_out_of_ticker( history_itr->op );
          last_min_his_id = history_itr->id;
          ++history_itr;
       }
@@ -760,6 +826,12 @@ void market_history_plugin::plugin_set_program_options(
            "or those meet the other option, which has more data (default: 259200 (3 days)). "
            "This parameter is reused for liquidity pools as operations in last X seconds per pool in history. "
            "Note: this parameter need to be greater than 24 hours to be able to serve market ticker data correctly.")
+         ("market-history-fill-store", boost::program_options::value<bool>()->default_value(false),
+           "Whether to keep all filled orders in a compact columnar store on disk and to roll up market history "
+           "buckets of any size from it at query time, instead of tracking buckets of the sizes in bucket-size. "
+           "Order history and trade history are then also served from the store without limits, and no order "
+           "history objects are kept. Fills from before the store was enabled are not served, unless the chain is "
+           "replayed (default: false)")
          ;
    cfg.add(cli);
 }
@@ -789,6 +861,8 @@ void market_history_plugin::plugin_initialize(const boost::program_options::vari
       my->_max_order_his_records_per_market = options["max-order-his-records-per-market"].as<uint32_t>();
    if( options.count( "max-order-his-seconds-per-market" ) > 0 )
       my->_max_order_his_seconds_per_market = options["max-order-his-seconds-per-market"].as<uint32_t>();
+   if( options.count( "market-history-fill-store" ) > 0 && options["market-history-fill-store"].as<bool>() )
+      my->_fill_store = std::make_unique<fill_store>();
 } FC_CAPTURE_AND_RETHROW() }
 
 void market_history_plugin::plugin_startup()
@@ -815,4 +889,9 @@ uint32_t market_history_plugin::max_order_his_seconds_per_market()const
    return my->_max_order_his_seconds_per_market;
 }
 
+const fill_store* market_history_plugin::get_fill_store()const
+{
+   return my->_fill_store.get();
+}
+
 } }
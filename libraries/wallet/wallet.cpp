@@ -307,6 +307,7 @@ vector<operation_detail> wallet_api::get_account_history(const string& name, uin
             operation_history_id_type(),
             page_limit,
             start );
+      my->cache_objects_of( current );
       bool first_row = true;
       for( auto& o : current )
       {
@@ -360,6 +361,7 @@ vector<operation_detail> wallet_api::get_relative_account_history(
             stop,
             page_size,
             start);
+      my->cache_objects_of(current);
       for (auto &o : current) {
          std::stringstream ss;
          auto memo = o.op.visit(detail::operation_printer(ss, *my, o));
@@ -397,6 +399,7 @@ account_history_operation_detail wallet_api::get_account_history_by_operations(
     while (limit > 0 && start <= stats.total_ops) {
         uint32_t min_limit = std::min(default_page_size, limit);
         auto current = my->_remote_hist->get_account_history_by_operations(name, operation_types, start, min_limit);
+        my->cache_objects_of(current.operation_history_objs);
         auto his_rend = current.operation_history_objs.rend();
         for( auto it = current.operation_history_objs.rbegin(); it != his_rend; ++it )
         {
@@ -1495,7 +1498,7 @@ blind_confirmation wallet_api::transfer_from_blind( string from_blind_account_ke
    transfer_from_blind_operation from_blind;
 
 
-   auto fees  = my->_remote_db->get_global_properties().parameters.get_current_fees();
+   auto fees  = my->get_global_properties().parameters.get_current_fees();
    fc::optional<asset_object> asset_obj = get_asset(symbol);
    FC_ASSERT(asset_obj.valid(), "Could not find asset matching ${asset}", ("asset", symbol));
    auto amount = asset_obj->amount_from_string(amount_in);
@@ -1575,7 +1578,7 @@ blind_confirmation wallet_api::blind_transfer_help( string from_key_or_label,
    blind_transfer_operation blind_tr;
    blind_tr.outputs.resize(2);
 
-   auto fees  = my->_remote_db->get_global_properties().parameters.get_current_fees();
+   auto fees  = my->get_global_properties().parameters.get_current_fees();
 
    auto amount = asset_obj->amount_from_string(amount_in);
 
@@ -1803,7 +1806,7 @@ blind_confirmation wallet_api::transfer_to_blind( string from_account_id_or_name
               [&]( const blind_output& a, const blind_output& b ){ return a.commitment < b.commitment; } );
 
    confirm.trx.operations.push_back( bop );
-   my->set_operation_fees( confirm.trx, my->_remote_db->get_global_properties().parameters.get_current_fees());
+   my->set_operation_fees( confirm.trx, my->get_global_properties().parameters.get_current_fees());
    confirm.trx.validate();
    confirm.trx = sign_transaction(confirm.trx, broadcast);
 
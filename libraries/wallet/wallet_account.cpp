@@ -76,7 +76,7 @@ namespace graphene { namespace wallet { namespace detail {
 
       signed_transaction tx;
       tx.operations.push_back( account_create_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.get_current_fees() );
+      set_operation_fees( tx, get_global_properties().parameters.get_current_fees() );
       tx.validate();
 
       return sign_transaction(tx, broadcast);
@@ -94,7 +94,7 @@ namespace graphene { namespace wallet { namespace detail {
       op.account_to_upgrade = account_obj.get_id();
       op.upgrade_to_lifetime_member = true;
       tx.operations = {op};
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.get_current_fees() );
+      set_operation_fees( tx, get_global_properties().parameters.get_current_fees() );
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -138,7 +138,7 @@ namespace graphene { namespace wallet { namespace detail {
 
          signed_transaction tx;
          tx.operations.push_back(op);
-         set_operation_fees( tx, _remote_db->get_global_properties().parameters.get_current_fees());
+         set_operation_fees( tx, get_global_properties().parameters.get_current_fees());
          tx.validate();
 
          return sign_transaction(tx, broadcast);
@@ -192,12 +192,24 @@ namespace graphene { namespace wallet { namespace detail {
       _wallet.pending_witness_registrations.erase(iter);
    }
 
+   void wallet_api_impl::cache_account( const account_object& account )const
+   {
+      _account_cache[account.get_id()] = account;
+      _account_ids_by_name[account.name] = account.get_id();
+   }
+
    account_object wallet_api_impl::get_account(account_id_type id) const
    {
+      auto itr = _account_cache.find(id);
+      if( itr != _account_cache.end() )
+         return itr->second;
+
       std::string account_id = account_id_to_string(id);
 
-      auto rec = _remote_db->get_accounts({account_id}, {}).front();
+      // Subscribe, to be notified when the account changes
+      auto rec = _remote_db->get_accounts({account_id}, true).front();
       FC_ASSERT(rec);
+      cache_account(*rec);
       return *rec;
    }
 
@@ -210,8 +222,13 @@ namespace graphene { namespace wallet { namespace detail {
          // It's an ID
          return get_account(*id);
       } else {
-         auto rec = _remote_db->lookup_account_names({account_name_or_id}).front();
+         auto name_itr = _account_ids_by_name.find(account_name_or_id);
+         if( name_itr != _account_ids_by_name.end() )
+            return get_account(name_itr->second);
+
+         auto rec = _remote_db->get_accounts({account_name_or_id}, true).front();
          FC_ASSERT( rec && rec->name == account_name_or_id );
+         cache_account(*rec);
          return *rec;
       }
    }
@@ -260,7 +277,7 @@ namespace graphene { namespace wallet { namespace detail {
 
          signed_transaction tx;
          tx.operations.push_back( account_create_op );
-         set_operation_fees( tx, _remote_db->get_global_properties().parameters.get_current_fees());
+         set_operation_fees( tx, get_global_properties().parameters.get_current_fees());
          tx.validate();
 
          // we do not insert owner_privkey here because
@@ -282,7 +299,7 @@ namespace graphene { namespace wallet { namespace detail {
 
       signed_transaction tx;
       tx.operations.push_back( whitelist_op );
-      set_operation_fees( tx, _remote_db->get_global_properties().parameters.get_current_fees());
+      set_operation_fees( tx, get_global_properties().parameters.get_current_fees());
       tx.validate();
 
       return sign_transaction( tx, broadcast );
@@ -407,7 +424,7 @@ namespace graphene { namespace wallet { namespace detail {
          tx.operations.reserve( ctx.ops.size() );
          for( const balance_claim_operation& op : ctx.ops )
             tx.operations.emplace_back( op );
-         set_operation_fees( tx, _remote_db->get_global_properties().parameters.get_current_fees() );
+         set_operation_fees( tx, get_global_properties().parameters.get_current_fees() );
          tx.validate();
          signed_transaction signed_tx = sign_transaction( tx, false );
          for( const address& addr : ctx.addrs )
@@ -417,7 +434,10 @@ namespace graphene { namespace wallet { namespace detail {
          boost::erase(signed_tx.signatures, boost::unique<boost::return_found_end>(boost::sort(signed_tx.signatures)));
          result.push_back( signed_tx );
          if( broadcast )
+         {
             _remote_net_broadcast->broadcast_transaction(signed_tx);
+            forget_objects_of(signed_tx);
+         }
       }
 
       return result;
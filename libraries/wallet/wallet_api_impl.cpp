@@ -78,6 +78,10 @@ namespace graphene { namespace wallet { namespace detail {
       {
          on_block_applied( block_id );
       } );
+      _remote_db->set_subscribe_callback( [this](const variant& updates )
+      {
+         on_objects_changed( updates );
+      }, false );
 
       _wallet.chain_id = _chain_id;
       _wallet.ws_server = initial_data.ws_server;
@@ -176,18 +180,119 @@ namespace graphene { namespace wallet { namespace detail {
    }
    global_property_object wallet_api_impl::get_global_properties() const
    {
-      return _remote_db->get_global_properties();
+      if( !_global_properties_cache.valid() )
+      {
+         // subscribe, to be notified when the properties change
+         auto obj = _remote_db->get_objects( { global_property_id_type() }, true ).front();
+         _global_properties_cache = obj.as<global_property_object>( GRAPHENE_MAX_NESTED_OBJECTS );
+      }
+      return *_global_properties_cache;
    }
    dynamic_global_property_object wallet_api_impl::get_dynamic_global_properties() const
    {
-      return _remote_db->get_dynamic_global_properties();
+      if( !_dynamic_global_properties_cache.valid() )
+         _dynamic_global_properties_cache = _remote_db->get_dynamic_global_properties();
+      return *_dynamic_global_properties_cache;
    }
 
    void wallet_api_impl::on_block_applied( const variant& block_id )
    {
+      _dynamic_global_properties_cache.reset();
+      _asset_cache.clear();
       fc::async([this]{resync();}, "Resync after block");
    }
 
+   void wallet_api_impl::on_objects_changed( const variant& updates )
+   {
+      if( !updates.is_array() )
+         return;
+      for( const variant& update : updates.get_array() )
+      {
+         object_id_type id;
+         if( update.is_object() && update.get_object().contains( "id" ) )
+            id = update.get_object()["id"].as<object_id_type>( 1 );
+         else if( update.is_string() )
+            id = update.as<object_id_type>( 1 );
+         else
+            continue;
+
+         if( id.is<account_id_type>() )
+            _account_cache.erase( account_id_type( id ) );
+         else if( id.is<asset_id_type>() )
+            _asset_cache.erase( asset_id_type( id ) );
+         else if( id.is<global_property_id_type>() )
+            _global_properties_cache.reset();
+      }
+   }
+
+   /// Collects IDs of accounts and assets from a variant of an operation
+   static void collect_object_ids( const variant& v, flat_set<account_id_type>& accounts,
+                                   flat_set<asset_id_type>& assets )
+   {
+      if( v.is_object() )
+      {
+         for( const auto& entry : v.get_object() )
+            collect_object_ids( entry.value(), accounts, assets );
+      }
+      else if( v.is_array() )
+      {
+         for( const auto& item : v.get_array() )
+            collect_object_ids( item, accounts, assets );
+      }
+      else if( v.is_string() )
+      {
+         const string& str = v.get_string();
+         if( str.compare( 0, 4, "1.2." ) == 0 )
+         {
+            if( auto id = maybe_id<account_id_type>( str ) )
+               accounts.insert( *id );
+         }
+         else if( str.compare( 0, 4, "1.3." ) == 0 )
+         {
+            if( auto id = maybe_id<asset_id_type>( str ) )
+               assets.insert( *id );
+         }
+      }
+   }
+
+   void wallet_api_impl::cache_objects_of( const vector<operation_history_object>& history )const
+   {
+      flat_set<account_id_type> accounts;
+      flat_set<asset_id_type> assets;
+      for( const auto& o : history )
+         collect_object_ids( fc::variant( o.op, GRAPHENE_MAX_NESTED_OBJECTS ), accounts, assets );
+
+      vector<string> account_ids;
+      for( const auto& id : accounts )
+         if( _account_cache.find( id ) == _account_cache.end() )
+            account_ids.push_back( account_id_to_string( id ) );
+      if( !account_ids.empty() )
+         for( const auto& rec : _remote_db->get_accounts( account_ids, true ) )
+            if( rec.valid() )
+               cache_account( *rec );
+
+      vector<string> asset_ids;
+      for( const auto& id : assets )
+         if( _asset_cache.find( id ) == _asset_cache.end() )
+            asset_ids.push_back( asset_id_to_string( id ) );
+      if( !asset_ids.empty() )
+         for( const auto& rec : _remote_db->get_assets( asset_ids, true ) )
+            if( rec.valid() )
+               cache_asset( *rec );
+   }
+
+   void wallet_api_impl::forget_objects_of( const transaction& tx )const
+   {
+      flat_set<account_id_type> accounts;
+      flat_set<asset_id_type> assets;
+      for( const auto& op : tx.operations )
+         collect_object_ids( fc::variant( op, GRAPHENE_MAX_NESTED_OBJECTS ), accounts, assets );
+      for( const auto& id : accounts )
+         _account_cache.erase( id );
+      for( const auto& id : assets )
+         _asset_cache.erase( id );
+   }
+
    void wallet_api_impl::set_operation_fees( signed_transaction& tx, const fee_schedule& s  )
    {
       for( auto& op : tx.operations )
@@ -112,6 +112,23 @@ public:
     */
    void on_block_applied( const variant& block_id );
 
+   /***
+    * @brief called when the remote node notifies changes of subscribed objects
+    */
+   void on_objects_changed( const variant& updates );
+
+   /***
+    * @brief fetch the accounts and assets referenced by a page of history into the object cache,
+    * with one batched call per object type
+    */
+   void cache_objects_of( const vector<operation_history_object>& history )const;
+
+   /***
+    * @brief drop the cached accounts and assets referenced by a transaction that is broadcast,
+    * because the node only notifies changes once they are in a block
+    */
+   void forget_objects_of( const transaction& tx )const;
+
    /**
     * @brief make a copy of the wallet file
     * Note: this will not overwrite. It simply adds a version suffix.
@@ -446,6 +463,20 @@ private:
    fc::mutex _resync_mutex;
    void resync();
 
+   void cache_account( const account_object& account )const;
+   void cache_asset( const extended_asset_object& asset )const;
+
+   // Objects fetched from the remote node. Accounts and global properties are subscribed to when fetched and
+   // dropped when the node notifies a change. Assets, whose collateral data may change without notification,
+   // and dynamic global properties are dropped whenever a block is applied.
+   // Names and symbols never change, so their mappings to IDs are kept.
+   mutable map<account_id_type, account_object>        _account_cache;
+   mutable map<string, account_id_type>                _account_ids_by_name;
+   mutable map<asset_id_type, extended_asset_object>   _asset_cache;
+   mutable map<string, asset_id_type>                  _asset_ids_by_symbol;
+   mutable optional<global_property_object>            _global_properties_cache;
+   mutable optional<dynamic_global_property_object>    _dynamic_global_properties_cache;
+
    void init_prototype_ops();
 
    map<transaction_handle_type, signed_transaction> _builder_transactions;
@@ -315,6 +315,7 @@ namespace graphene { namespace wallet { namespace detail {
          try
          {
             _remote_net_broadcast->broadcast_transaction( tx );
+            forget_objects_of( tx );
          }
          catch ( const fc::exception &e )
          {
@@ -385,6 +386,7 @@ namespace graphene { namespace wallet { namespace detail {
          try
          {
             _remote_net_broadcast->broadcast_transaction( tx );
+            forget_objects_of( tx );
          }
          catch (const fc::exception& e)
          {
@@ -33,6 +33,7 @@
 #include <graphene/market_history/market_history_plugin.hpp>
 #include <graphene/witness/witness.hpp>
 #include <graphene/grouped_orders/grouped_orders_plugin.hpp>
+#include <graphene/delayed_node/delayed_node_plugin.hpp>
 
 #include <fc/thread/thread.hpp>
 #include <fc/log/appender.hpp>
@@ -391,6 +392,78 @@ BOOST_AUTO_TEST_CASE( two_node_network )
    }
 }
 
+/////////////
+/// @brief sync a delayed node from a trusted node running in-process
+/////////////
+BOOST_AUTO_TEST_CASE( delayed_node_sync )
+{
+   using namespace graphene::chain;
+   using namespace graphene::app;
+   try {
+      BOOST_TEST_MESSAGE( "Creating and initializing trusted node" );
+
+      fc::temp_directory app_dir( graphene::utilities::temp_directory_path() );
+      auto genesis_file = create_genesis_file(app_dir);
+
+      auto rpc_port = fc::network::get_available_port();
+      auto p2p_port = rpc_port;
+      for( size_t i = 0; i < 10 && p2p_port == rpc_port; ++i )
+         p2p_port = fc::network::get_available_port();
+      BOOST_REQUIRE( p2p_port != rpc_port );
+
+      graphene::app::application app1;
+      auto sharable_cfg = std::make_shared<boost::program_options::variables_map>();
+      auto& cfg = *sharable_cfg;
+      fc::set_option( cfg, "rpc-endpoint", string("127.0.0.1:") + std::to_string(rpc_port) );
+      fc::set_option( cfg, "p2p-endpoint", string("127.0.0.1:") + std::to_string(p2p_port) );
+      fc::set_option( cfg, "genesis-json", genesis_file );
+      fc::set_option( cfg, "seed-nodes", string("[]") );
+      app1.initialize(app_dir.path(), sharable_cfg);
+      app1.startup();
+
+      std::shared_ptr<chain::database> db1 = app1.chain_database();
+      fc::ecc::private_key committee_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("nathan")));
+      // more blocks than the sync window, so that the window has to slide
+      for( uint32_t i = 0; i < 50; ++i )
+         db1->generate_block( db1->get_slot_time(1), db1->get_scheduled_witness(1), committee_key,
+                              database::skip_nothing );
+      const uint32_t trusted_lib = db1->get_dynamic_global_properties().last_irreversible_block_num;
+      BOOST_REQUIRE_GT( trusted_lib, 20u );
+
+      BOOST_TEST_MESSAGE( "Creating and initializing delayed node" );
+
+      fc::temp_directory app2_dir( graphene::utilities::temp_directory_path() );
+      graphene::app::application app2;
+      app2.register_plugin< graphene::delayed_node::delayed_node_plugin >( true );
+      auto sharable_cfg2 = std::make_shared<boost::program_options::variables_map>();
+      auto& cfg2 = *sharable_cfg2;
+      fc::set_option( cfg2, "genesis-json", genesis_file );
+      fc::set_option( cfg2, "seed-nodes", string("[]") );
+      fc::set_option( cfg2, "trusted-node", string("127.0.0.1:") + std::to_string(rpc_port) );
+      fc::set_option( cfg2, "delayed-node-sync-window", uint32_t(8) );
+      app2.initialize(app2_dir.path(), sharable_cfg2);
+      app2.startup();
+
+      std::shared_ptr<chain::database> db2 = app2.chain_database();
+
+      // the delayed node only starts syncing when it is notified about a new block
+      db1->generate_block( db1->get_slot_time(1), db1->get_scheduled_witness(1), committee_key,
+                           database::skip_nothing );
+      const uint32_t target_lib = db1->get_dynamic_global_properties().last_irreversible_block_num;
+
+      fc::wait_for( fc::seconds(30), [db2,target_lib] () {
+         return db2->head_block_num() >= target_lib;
+      });
+
+      BOOST_REQUIRE_EQUAL( db2->head_block_num(), target_lib );
+      BOOST_CHECK( db2->head_block_id() == db1->fetch_block_by_number( target_lib )->id() );
+
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 /// a contrived example to test the breaking out of application_impl to a header file
 BOOST_AUTO_TEST_CASE(application_impl_breakout) {
 
@@ -1379,6 +1379,122 @@ BOOST_FIXTURE_TEST_CASE( account_history_pagination, cli_fixture )
 }
 
 
+///////////////////////
+// Check that the wallet drops a cached account when another wallet changes it
+///////////////////////
+BOOST_FIXTURE_TEST_CASE( cli_wallet_cache_account_update, cli_fixture )
+{
+   try
+   {
+      INVOKE(upgrade_nathan_account);
+      BOOST_CHECK(generate_block(app1));
+
+      // fill the cache of the first wallet
+      account_object nathan_before = con.wallet_api_ptr->get_account("nathan");
+      account_object init0 = con.wallet_api_ptr->get_account("init0");
+      BOOST_REQUIRE( nathan_before.options.voting_account != init0.get_id() );
+
+      // change nathan from a second wallet, so that the first one only learns about it from the node
+      client_connection con2(app1, app_dir, server_port_number, "wallet2.json");
+      con2.wallet_api_ptr->set_password("supersecret");
+      con2.wallet_api_ptr->unlock("supersecret");
+      BOOST_CHECK(con2.wallet_api_ptr->import_key("nathan", nathan_keys[0]));
+
+      BOOST_TEST_MESSAGE("Setting voting proxy of nathan from another wallet");
+      con2.wallet_api_ptr->set_voting_proxy("nathan", "init0", true);
+      BOOST_CHECK(generate_block(app1));
+
+      fc::wait_for( fc::seconds(5), [&con,&init0] {
+         return con.wallet_api_ptr->get_account("nathan").options.voting_account == init0.get_id();
+      });
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+///////////////////////
+// Check that the wallet drops a cached asset when another wallet changes it
+///////////////////////
+BOOST_FIXTURE_TEST_CASE( cli_wallet_cache_asset_update, cli_fixture )
+{
+   try
+   {
+      INVOKE(upgrade_nathan_account);
+
+      BOOST_TEST_MESSAGE("Create UIA 'BOBCOIN'");
+      graphene::chain::asset_options asset_ops;
+      asset_ops.issuer_permissions = DEFAULT_UIA_ASSET_ISSUER_PERMISSION;
+      asset_ops.flags = charge_market_fee | override_authority;
+      asset_ops.max_supply = 1000000;
+      asset_ops.core_exchange_rate = price(asset(2),asset(1,asset_id_type(1)));
+      con.wallet_api_ptr->create_asset("nathan", "BOBCOIN", 4, asset_ops, {}, true);
+      BOOST_CHECK(generate_block(app1));
+
+      // fill the cache of the first wallet
+      auto bobcoin = con.wallet_api_ptr->get_asset("BOBCOIN");
+      BOOST_REQUIRE_EQUAL( bobcoin.options.market_fee_percent, 0 );
+
+      // change BOBCOIN from a second wallet, so that the first one only learns about it from the node
+      client_connection con2(app1, app_dir, server_port_number, "wallet2.json");
+      con2.wallet_api_ptr->set_password("supersecret");
+      con2.wallet_api_ptr->unlock("supersecret");
+      BOOST_CHECK(con2.wallet_api_ptr->import_key("nathan", nathan_keys[0]));
+
+      BOOST_TEST_MESSAGE("Updating market fee of BOBCOIN from another wallet");
+      graphene::chain::asset_options new_ops = bobcoin.options;
+      new_ops.market_fee_percent = 100;
+      con2.wallet_api_ptr->update_asset("BOBCOIN", {}, new_ops, true);
+      BOOST_CHECK(generate_block(app1));
+
+      fc::wait_for( fc::seconds(5), [&con] {
+         return con.wallet_api_ptr->get_asset("BOBCOIN").options.market_fee_percent == 100;
+      });
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+///////////////////////
+// Check that account history descriptions still show names when accounts and assets come from the cache
+///////////////////////
+BOOST_FIXTURE_TEST_CASE( cli_wallet_cache_history_names, cli_fixture )
+{
+   try
+   {
+      INVOKE(create_new_account);
+
+      BOOST_TEST_MESSAGE("Transferring bitshares from Nathan to jmjatlanta");
+      for(int i = 1; i <= 3; i++)
+      {
+         con.wallet_api_ptr->transfer("nathan", "jmjatlanta", std::to_string(i), "1.3.0", "", true);
+      }
+      BOOST_CHECK(generate_block(app1));
+
+      // read the history twice, the second time names are resolved from the cache
+      for(int round = 0; round < 2; round++)
+      {
+         auto history = con.wallet_api_ptr->get_account_history("jmjatlanta", 10);
+         BOOST_REQUIRE_EQUAL( history.size(), 5u );
+         size_t transfers = 0;
+         for( const auto& op : history )
+         {
+            if( op.description.find("Transfer") == string::npos )
+               continue;
+            ++transfers;
+            BOOST_CHECK( op.description.find("from nathan to jmjatlanta") != string::npos );
+            BOOST_CHECK( op.description.find(GRAPHENE_SYMBOL) != string::npos );
+         }
+         BOOST_CHECK_EQUAL( transfers, 4u );
+      }
+   } catch( fc::exception& e ) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+
 ///////////////////////
 // Create a multi-sig account and verify that only when all signatures are
 // signed, the transaction could be broadcast
@@ -48,6 +48,7 @@
 #include <iomanip>
 
 #include "database_fixture.hpp"
+#include "es_stand_in.hpp"
 
 using namespace graphene::chain::test;
 
@@ -370,6 +371,30 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
       fc::set_option( options, "es-objects-index-prefix", fixture.es_obj_index_prefix );
    }
 
+   if( fixture.current_test_name == "es_objects_bulk_stand_in" ) {
+      fixture.es_stand_in_server = std::make_shared<es_stand_in>();
+      fixture.app.register_plugin<graphene::es_objects::es_objects_plugin>(true);
+
+      fc::set_option( options, "es-objects-elasticsearch-url", fixture.es_stand_in_server->url() );
+      // large bulks, so that everything is coalesced until the plugin is shut down
+      fc::set_option( options, "es-objects-bulk-replay", uint32_t(100000) );
+      fc::set_option( options, "es-objects-bulk-sync", uint32_t(100000) );
+      fc::set_option( options, "es-objects-balances", true );
+   }
+
+   if( fixture.current_test_name == "es_objects_bulk_failure" ) {
+      fixture.es_stand_in_server = std::make_shared<es_stand_in>();
+      fixture.app.register_plugin<graphene::es_objects::es_objects_plugin>(true);
+
+      fc::set_option( options, "es-objects-elasticsearch-url", fixture.es_stand_in_server->url() );
+      // send every block, wait for the previous bulk, and do not retry
+      fc::set_option( options, "es-objects-bulk-replay", uint32_t(1) );
+      fc::set_option( options, "es-objects-bulk-sync", uint32_t(1) );
+      fc::set_option( options, "es-objects-max-pending-bulks", uint32_t(1) );
+      fc::set_option( options, "es-objects-max-send-retries", uint32_t(0) );
+      fc::set_option( options, "es-objects-balances", true );
+   }
+
    if( fixture.current_test_name == "asset_in_collateral"
             || fixture.current_test_name == "htlc_database_api"
             || fixture.current_test_name == "liquidity_pool_apis_test"
@@ -386,6 +411,8 @@ std::shared_ptr<boost::program_options::variables_map> database_fixture_base::in
    }
 
    fc::set_option( options, "bucket-size", string("[15]") );
+   if( fixture.current_test_name == "get_market_history_from_fill_store" )
+      fc::set_option( options, "market-history-fill-store", true );
 
    fixture.app.register_plugin<graphene::market_history::market_history_plugin>(true);
    fixture.app.register_plugin<graphene::grouped_orders::grouped_orders_plugin>(true);
@@ -195,6 +195,8 @@ public:
 };
 
 namespace test {
+class es_stand_in;
+
 /// set a reasonable expiration time for the transaction
 void set_expiration( const database& db, transaction& tx );
 
@@ -225,6 +227,7 @@ struct database_fixture_base {
 
    string es_index_prefix; ///< Index prefix for elasticsearch plugin
    string es_obj_index_prefix; ///< Index prefix for es_objects plugin
+   std::shared_ptr<test::es_stand_in> es_stand_in_server; ///< Local Elasticsearch stand-in for es_objects plugin
 
    const std::string current_test_name;
    const std::string current_suite_name;
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <fc/network/http/server.hpp>
+#include <fc/network/ip.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <boost/algorithm/string.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace graphene { namespace chain { namespace test {
+
+/////////
+/// @brief A minimal local stand-in for an Elasticsearch node.
+/// It accepts every bulk request and records the bulk lines it receives, unless it is set to fail.
+/// The server runs on its own thread, so that it keeps answering while the caller blocks.
+/////////
+class es_stand_in
+{
+   public:
+      es_stand_in() : _thread( "es stand-in" )
+      {
+         _thread.async( [this]() {
+            _server = std::make_unique<fc::http::server>();
+            _server->on_request( [this]( const fc::http::request& req, const fc::http::server::response& resp ) {
+               std::string reply = "{}";
+               auto status = fc::http::reply::OK;
+               if( boost::algorithm::ends_with( req.path, "_bulk" ) && _failing )
+                  status = fc::http::reply::InternalServerError;
+               else if( boost::algorithm::ends_with( req.path, "_bulk" ) )
+               {
+                  std::vector<std::string> lines;
+                  std::string body( req.body.begin(), req.body.end() );
+                  boost::split( lines, body, boost::is_any_of("\n") );
+                  std::lock_guard<std::mutex> guard( _mutex );
+                  for( auto& line : lines )
+                     if( !line.empty() )
+                        _bulk_lines.emplace_back( std::move(line) );
+                  ++_bulk_requests;
+                  reply = "{\"errors\":false}";
+               }
+               resp.set_status( status );
+               resp.set_length( reply.size() );
+               resp.write( reply.c_str(), reply.size() );
+            });
+            _server->listen( fc::ip::endpoint( fc::ip::address("127.0.0.1"), 0 ) );
+            _port = _server->get_local_endpoint().port();
+         }).wait();
+      }
+
+      ~es_stand_in()
+      {
+         _thread.async( [this]() { _server.reset(); } ).wait();
+         _thread.quit();
+      }
+
+      /// @return the URL to be used as Elasticsearch node URL
+      std::string url()const
+      {
+         return "http://127.0.0.1:" + std::to_string( _port ) + "/";
+      }
+
+      uint32_t bulk_requests()const
+      {
+         std::lock_guard<std::mutex> guard( _mutex );
+         return _bulk_requests;
+      }
+
+      std::vector<std::string> bulk_lines()const
+      {
+         std::lock_guard<std::mutex> guard( _mutex );
+         return _bulk_lines;
+      }
+
+      /// Lets the following bulk requests fail with an HTTP error
+      void set_failing( bool failing )
+      {
+         _failing = failing;
+      }
+
+      void clear_bulk_lines()
+      {
+         std::lock_guard<std::mutex> guard( _mutex );
+         _bulk_lines.clear();
+      }
+
+   private:
+      fc::thread                         _thread;
+      std::unique_ptr<fc::http::server>  _server;
+      uint16_t                           _port = 0;
+      mutable std::mutex                 _mutex;
+      uint32_t                           _bulk_requests = 0;
+      std::atomic<bool>                  _failing { false };
+      std::vector<std::string>           _bulk_lines;
+};
+
+} } } // graphene::chain::test
@@ -0,0 +1,595 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "loopback_network.hpp"
+
+#include <graphene/net/exceptions.hpp>
+#include <graphene/utilities/tempdir.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <deque>
+#include <limits>
+#include <random>
+
+namespace graphene { namespace net {
+
+static const size_t relay_chunk_size = 4096;
+
+struct impaired_link::direction
+{
+   direction( std::shared_ptr<fc::tcp_socket> f, std::shared_ptr<fc::tcp_socket> t, std::atomic<uint64_t>& c )
+   : from( std::move(f) ), to( std::move(t) ), counter( c ) {}
+
+   std::shared_ptr<fc::tcp_socket>                            from;
+   std::shared_ptr<fc::tcp_socket>                            to;
+   std::atomic<uint64_t>&                                     counter;
+   /// chunks of data with the time they are due to be delivered
+   std::deque<std::pair<fc::time_point, std::vector<char>>>   queue;
+   /// when the link has finished sending the last chunk, to limit bandwidth
+   fc::time_point                                             transmitter_free;
+   fc::time_point                                             last_due;
+   bool                                                       closed = false;
+};
+
+impaired_link::impaired_link( fc::thread& relay_thread, const fc::ip::endpoint& target,
+                              const link_conditions& conditions, uint32_t seed )
+: _relay_thread( relay_thread ), _target( target ), _conditions( conditions ), _random_state( seed | 1 )
+{
+   _relay_thread.async( [this]() {
+      _server.set_reuse_address();
+      _server.listen( fc::ip::endpoint( fc::ip::address( "127.0.0.1" ), 0 ) );
+      _endpoint = _server.get_local_endpoint();
+      _accept_done = fc::async( [this]() { accept_loop(); }, "impaired_link accept" );
+   }, "impaired_link listen" ).wait();
+}
+
+impaired_link::~impaired_link()
+{
+   _relay_thread.async( [this]() {
+      _server.close();
+      if( _accept_done.valid() && !_accept_done.ready() )
+         _accept_done.cancel_and_wait( "~impaired_link()" );
+      for( auto& done : _pumps_done )
+         if( done.valid() && !done.ready() )
+            done.cancel_and_wait( "~impaired_link()" );
+   }, "~impaired_link" ).wait();
+}
+
+void impaired_link::accept_loop()
+{
+   while( true )
+   {
+      auto client = std::make_shared<fc::tcp_socket>();
+      try
+      {
+         _server.accept( *client );
+      }
+      catch( const fc::canceled_exception& )
+      {
+         throw;
+      }
+      catch( const fc::exception& )
+      {
+         return; // the server has been closed
+      }
+      relay( client );
+   }
+}
+
+void impaired_link::relay( std::shared_ptr<fc::tcp_socket> client )
+{
+   auto server_side = std::make_shared<fc::tcp_socket>();
+   try
+   {
+      server_side->connect_to( _target );
+   }
+   catch( const fc::exception& e )
+   {
+      wlog( "Unable to relay a connection to ${t}: ${e}", ("t",_target)("e",e.to_detail_string()) );
+      client->close();
+      return;
+   }
+   auto up = std::make_shared<direction>( client, server_side, _bytes_to_target );
+   auto down = std::make_shared<direction>( server_side, client, _bytes_from_target );
+   for( const auto& dir : { up, down } )
+   {
+      _pumps_done.push_back( fc::async( [this,dir]() { read_loop( dir ); }, "impaired_link read" ) );
+      _pumps_done.push_back( fc::async( [this,dir]() { write_loop( dir ); }, "impaired_link write" ) );
+   }
+}
+
+bool impaired_link::lose_chunk()
+{
+   if( _conditions.loss_rate <= 0 )
+      return false;
+   // xorshift32, so that runs with the same seed lose the same chunks
+   _random_state ^= _random_state << 13;
+   _random_state ^= _random_state >> 17;
+   _random_state ^= _random_state << 5;
+   return _random_state < _conditions.loss_rate * std::numeric_limits<uint32_t>::max();
+}
+
+void impaired_link::read_loop( std::shared_ptr<direction> dir )
+{
+   std::vector<char> buffer( relay_chunk_size );
+   try
+   {
+      while( true )
+      {
+         const size_t n = dir->from->readsome( buffer.data(), buffer.size() );
+         const fc::time_point now = fc::time_point::now();
+         fc::time_point sent = now;
+         if( _conditions.bandwidth > 0 )
+         {
+            sent = std::max( now, dir->transmitter_free )
+                   + fc::microseconds( int64_t( n * 1000000 / _conditions.bandwidth ) );
+            dir->transmitter_free = sent;
+         }
+         fc::time_point due = sent + _conditions.latency;
+         if( lose_chunk() )
+            due += _conditions.retransmit_delay;
+         // a stream is delivered in order, so a lost chunk holds up everything behind it
+         due = std::max( due, dir->last_due );
+         dir->last_due = due;
+         dir->queue.emplace_back( due, std::vector<char>( buffer.begin(), buffer.begin() + n ) );
+      }
+   }
+   catch( const fc::canceled_exception& )
+   {
+      throw;
+   }
+   catch( const fc::exception& )
+   {
+      // the connection has been closed
+   }
+   dir->closed = true;
+}
+
+void impaired_link::write_loop( std::shared_ptr<direction> dir )
+{
+   try
+   {
+      while( !dir->closed || !dir->queue.empty() )
+      {
+         if( dir->queue.empty() )
+         {
+            fc::usleep( fc::milliseconds(1) );
+            continue;
+         }
+         const fc::time_point now = fc::time_point::now();
+         const auto& front = dir->queue.front();
+         if( front.first > now )
+         {
+            fc::usleep( front.first - now );
+            continue;
+         }
+         const std::vector<char>& data = front.second;
+         size_t written = 0;
+         while( written < data.size() )
+            written += dir->to->writesome( data.data() + written, data.size() - written );
+         dir->counter += data.size();
+         dir->queue.pop_front();
+      }
+   }
+   catch( const fc::canceled_exception& )
+   {
+      throw;
+   }
+   catch( const fc::exception& )
+   {
+      // the connection has been closed
+   }
+   // closing both sockets ends the other direction too
+   dir->to->close();
+   dir->from->close();
+}
+
+/// Keeps a linear chain of blocks and the transactions seen, accepting anything that links
+class loopback_network::delegate : public node_delegate
+{
+public:
+   delegate( loopback_network& network ) : _network( network ) {}
+
+   void append_block( const signed_block& b )
+   {
+      for( const auto& trx : b.transactions )
+         _transactions.emplace( message( trx_message( trx ) ).id(), trx );
+      _chain.push_back( b.id() );
+      _blocks.emplace( _chain.back(), b );
+   }
+
+   block_id_type head_block_id()const { return _chain.empty() ? block_id_type() : _chain.back(); }
+   uint32_t      head_block_num()const { return _chain.size(); }
+   fc::time_point_sec head_block_time()const
+   {
+      return _chain.empty() ? _network._genesis_time : _blocks.at( _chain.back() ).timestamp;
+   }
+   bool          has_block( const block_id_type& id )const { return _blocks.find( id ) != _blocks.end(); }
+   uint64_t      known_transactions()const { return _transactions.size(); }
+
+   void add_transaction( const signed_transaction& trx )
+   {
+      _transactions.emplace( message( trx_message( trx ) ).id(), trx );
+   }
+
+   bool has_item( const net::item_id& id ) override
+   {
+      if( id.item_type == block_message_type )
+         return has_block( id.item_hash );
+      return _transactions.find( id.item_hash ) != _transactions.end();
+   }
+
+   bool handle_block( const block_message& blk_msg, bool sync_mode,
+                      std::vector<message_hash_type>& contained_transaction_msg_ids ) override
+   {
+      if( has_block( blk_msg.block_id ) )
+         return false;
+      if( blk_msg.block.previous != head_block_id() )
+         FC_THROW_EXCEPTION( unlinkable_block_exception, "block does not link to head" );
+      append_block( blk_msg.block );
+      for( const auto& trx : blk_msg.block.transactions )
+         contained_transaction_msg_ids.push_back( message( trx_message( trx ) ).id() );
+      if( !sync_mode )
+         _network.record_arrival( blk_msg.block_id, true );
+      return false;
+   }
+
+   void handle_transaction( const trx_message& trx_msg ) override
+   {
+      if( _transactions.emplace( message( trx_msg ).id(), trx_msg.trx ).second )
+         _network.record_arrival( trx_msg.trx.id(), false );
+   }
+
+   void handle_message( const message& message_to_process ) override {}
+
+   std::vector<item_hash_t> get_block_ids( const std::vector<item_hash_t>& blockchain_synopsis,
+                                           uint32_t& remaining_item_count, uint32_t limit ) override
+   {
+      std::vector<item_hash_t> result;
+      remaining_item_count = 0;
+      uint32_t last_known = 0;
+      for( auto itr = blockchain_synopsis.rbegin(); itr != blockchain_synopsis.rend(); ++itr )
+      {
+         if( *itr == item_hash_t() || has_block( *itr ) )
+         {
+            last_known = block_header::num_from_id( *itr );
+            break;
+         }
+      }
+      for( uint32_t num = std::max( last_known, 1u ); num <= head_block_num() && result.size() < limit; ++num )
+         result.push_back( _chain[ num - 1 ] );
+      if( !result.empty() && block_header::num_from_id( result.back() ) < head_block_num() )
+         remaining_item_count = head_block_num() - block_header::num_from_id( result.back() );
+      return result;
+   }
+
+   message get_item( const item_id& id ) override
+   {
+      if( id.item_type == block_message_type )
+      {
+         auto itr = _blocks.find( id.item_hash );
+         FC_ASSERT( itr != _blocks.end() );
+         return block_message( itr->second );
+      }
+      auto itr = _transactions.find( id.item_hash );
+      FC_ASSERT( itr != _transactions.end() );
+      return trx_message( itr->second );
+   }
+
+   chain_id_type get_chain_id()const override { return chain_id_type(); }
+
+   std::vector<item_hash_t> get_blockchain_synopsis( const item_hash_t& reference_point,
+                                                     uint32_t number_of_blocks_after_reference_point ) override
+   {
+      // the chain is linear and every block can be undone, see application_impl::get_blockchain_synopsis()
+      std::vector<item_hash_t> synopsis;
+      uint32_t high_block_num = head_block_num();
+      if( reference_point != item_hash_t() )
+      {
+         FC_ASSERT( has_block( reference_point ) );
+         high_block_num = block_header::num_from_id( reference_point );
+      }
+      if( 0 == high_block_num )
+         return synopsis;
+      const uint32_t true_high_block_num = high_block_num + number_of_blocks_after_reference_point;
+      for( uint32_t low_block_num = 1; low_block_num <= high_block_num;
+           low_block_num += ( true_high_block_num - low_block_num + 2 ) / 2 )
+         synopsis.push_back( _chain[ low_block_num - 1 ] );
+      return synopsis;
+   }
+
+   void sync_status( uint32_t item_type, uint32_t item_count ) override {}
+   void connection_count_changed( uint32_t c ) override {}
+
+   uint32_t get_block_number( const item_hash_t& block_id ) override
+   {
+      return block_header::num_from_id( block_id );
+   }
+
+   fc::time_point_sec get_block_time( const item_hash_t& block_id ) override
+   {
+      if( block_id == item_hash_t() )
+         return _network._genesis_time;
+      auto itr = _blocks.find( block_id );
+      return itr == _blocks.end() ? fc::time_point_sec::min() : itr->second.timestamp;
+   }
+
+   item_hash_t get_head_block_id()const override { return head_block_id(); }
+
+   uint32_t estimate_last_known_fork_from_git_revision_timestamp( uint32_t unix_timestamp )const override
+   {
+      return 0;
+   }
+
+   void error_encountered( const std::string& message, const fc::oexception& error ) override
+   {
+      elog( "${m}", ("m",message) );
+   }
+
+   uint8_t get_current_block_interval_in_seconds()const override { return 1; }
+
+private:
+   loopback_network&                                   _network;
+   std::vector<block_id_type>                          _chain;
+   std::map<block_id_type, signed_block>               _blocks;
+   std::map<message_hash_type, signed_transaction>     _transactions;
+};
+
+struct loopback_network::node_info
+{
+   explicit node_info( loopback_network& network )
+   : del( std::make_shared<delegate>( network ) ), dir( graphene::utilities::temp_directory_path() ) {}
+
+   node_ptr                    node;
+   std::shared_ptr<delegate>   del;
+   fc::temp_directory          dir;
+};
+
+loopback_network::loopback_network( uint32_t node_count )
+: _relay_thread( "loopback_network relay" ),
+  _genesis_time( fc::time_point::now() - fc::days(30) )
+{
+   _nodes.reserve( node_count );
+   for( uint32_t i = 0; i < node_count; ++i )
+      _nodes.push_back( std::make_shared<node_info>( *this ) );
+}
+
+loopback_network::~loopback_network()
+{
+   for( const auto& info : _nodes )
+      if( info->node )
+         info->node->close();
+   _links.clear();
+   _relay_thread.quit();
+}
+
+void loopback_network::connect( uint32_t from, uint32_t to, const link_conditions& conditions )
+{
+   FC_ASSERT( from < _nodes.size() && to < _nodes.size() && from != to );
+   for( const auto& l : _links )
+      if( ( l.from == from && l.to == to ) || ( l.from == to && l.to == from ) )
+         return;
+   _links.push_back( link_info{ from, to, conditions, nullptr } );
+}
+
+void loopback_network::connect_ring( const link_conditions& conditions )
+{
+   for( uint32_t i = 0; i < _nodes.size(); ++i )
+      connect( i, ( i + 1 ) % _nodes.size(), conditions );
+}
+
+void loopback_network::connect_random( uint32_t degree, const link_conditions& conditions, uint32_t seed )
+{
+   connect_ring( conditions );
+   std::mt19937 rng( seed );
+   std::uniform_int_distribution<uint32_t> pick( 0, _nodes.size() - 1 );
+   for( uint32_t i = 0; i < _nodes.size(); ++i )
+      for( uint32_t d = 0; d < degree; ++d )
+      {
+         const uint32_t to = pick( rng );
+         if( to != i )
+            connect( i, to, conditions );
+      }
+}
+
+bool loopback_network::is_started( uint32_t n )const
+{
+   return _nodes[n]->node != nullptr;
+}
+
+void loopback_network::start( const std::set<uint32_t>& delayed_nodes )
+{
+   for( uint32_t i = 0; i < _nodes.size(); ++i )
+      if( delayed_nodes.find( i ) == delayed_nodes.end() && !is_started( i ) )
+         start_node( i );
+}
+
+void loopback_network::start_node( uint32_t n )
+{
+   FC_ASSERT( n < _nodes.size() && !is_started( n ) );
+   node_info& info = *_nodes[n];
+
+   uint32_t link_count = 0;
+   for( const auto& l : _links )
+      if( l.from == n || l.to == n )
+         ++link_count;
+
+   info.node = std::make_shared<node>( "loopback network node " + std::to_string( n ) );
+   info.node->load_configuration( info.dir.path() );
+   info.node->set_node_delegate( info.del );
+   info.node->disable_peer_advertising();
+   info.node->set_advanced_node_parameters( fc::mutable_variant_object()
+         ( "desired_number_of_connections", link_count )
+         ( "maximum_number_of_connections", link_count ) );
+   info.node->listen_on_port( 0, false );
+   info.node->listen_to_p2p_network();
+   info.node->connect_to_p2p_network();
+   info.node->sync_from( item_id( block_message_type, info.del->head_block_id() ), std::vector<uint32_t>() );
+
+   dial_links();
+}
+
+void loopback_network::dial_links()
+{
+   for( uint32_t i = 0; i < _links.size(); ++i )
+   {
+      link_info& l = _links[i];
+      if( l.link || !is_started( l.from ) || !is_started( l.to ) )
+         continue;
+      const fc::ip::endpoint target( fc::ip::address( "127.0.0.1" ),
+                                     _nodes[l.to]->node->get_actual_listening_endpoint().port() );
+      l.link = std::make_unique<impaired_link>( _relay_thread, target, l.conditions, i + 1 );
+      _nodes[l.from]->node->connect_to_endpoint( l.link->endpoint() );
+   }
+}
+
+bool loopback_network::wait_for_connections( fc::microseconds timeout )
+{
+   const fc::time_point deadline = fc::time_point::now() + timeout;
+   while( true )
+   {
+      bool connected = true;
+      for( uint32_t i = 0; i < _nodes.size() && connected; ++i )
+      {
+         if( !is_started( i ) )
+            continue;
+         uint32_t expected = 0;
+         for( const auto& l : _links )
+            if( l.link && ( l.from == i || l.to == i ) )
+               ++expected;
+         connected = _nodes[i]->node->get_connection_count() >= expected;
+      }
+      if( connected )
+         return true;
+      if( fc::time_point::now() > deadline )
+         return false;
+      fc::usleep( fc::milliseconds(10) );
+   }
+}
+
+void loopback_network::preload_blocks( uint32_t n, uint32_t count )
+{
+   delegate& del = *_nodes[n]->del;
+   // blocks one second apart, ending now, so that peers find the chain plausible
+   const fc::time_point_sec now = fc::time_point::now();
+   for( uint32_t i = 0; i < count; ++i )
+   {
+      signed_block b;
+      b.previous = del.head_block_id();
+      b.timestamp = std::max( del.head_block_time() + 1, fc::time_point_sec( now - fc::seconds( count - i ) ) );
+      del.append_block( b );
+   }
+}
+
+block_id_type loopback_network::produce_block( uint32_t n, const std::vector<signed_transaction>& transactions )
+{
+   delegate& del = *_nodes[n]->del;
+   signed_block b;
+   b.previous = del.head_block_id();
+   b.timestamp = std::max( del.head_block_time(), fc::time_point_sec( fc::time_point::now() ) );
+   b.transactions.reserve( transactions.size() );
+   for( const auto& trx : transactions )
+      b.transactions.emplace_back( trx );
+   del.append_block( b );
+   const block_id_type id = b.id();
+   _origin_times[id] = fc::time_point::now();
+   _nodes[n]->node->broadcast( block_message( b ) );
+   return id;
+}
+
+void loopback_network::broadcast_transaction( uint32_t n, const signed_transaction& trx )
+{
+   _nodes[n]->del->add_transaction( trx );
+   _origin_times[trx.id()] = fc::time_point::now();
+   _nodes[n]->node->broadcast( trx_message( trx ) );
+}
+
+bool loopback_network::wait_for_block( const block_id_type& id, fc::microseconds timeout )
+{
+   const fc::time_point deadline = fc::time_point::now() + timeout;
+   while( true )
+   {
+      bool received = true;
+      for( uint32_t i = 0; i < _nodes.size() && received; ++i )
+         received = !is_started( i ) || _nodes[i]->del->has_block( id );
+      if( received )
+         return true;
+      if( fc::time_point::now() > deadline )
+         return false;
+      fc::usleep( fc::milliseconds(1) );
+   }
+}
+
+bool loopback_network::wait_for_transactions( uint64_t count, fc::microseconds timeout )
+{
+   const fc::time_point deadline = fc::time_point::now() + timeout;
+   while( true )
+   {
+      bool received = true;
+      for( uint32_t i = 0; i < _nodes.size() && received; ++i )
+         received = !is_started( i ) || _nodes[i]->del->known_transactions() >= count;
+      if( received )
+         return true;
+      if( fc::time_point::now() > deadline )
+         return false;
+      fc::usleep( fc::milliseconds(1) );
+   }
+}
+
+uint32_t loopback_network::head_block_num( uint32_t n )const
+{
+   return _nodes[n]->del->head_block_num();
+}
+
+const node_ptr& loopback_network::get_node( uint32_t n )const
+{
+   return _nodes[n]->node;
+}
+
+void loopback_network::clear_latencies()
+{
+   _block_latencies.clear();
+   _transaction_latencies.clear();
+}
+
+uint64_t loopback_network::bytes_of_node( uint32_t n )const
+{
+   uint64_t result = 0;
+   for( const auto& l : _links )
+      if( l.link && ( l.from == n || l.to == n ) )
+         result += l.link->bytes_to_target() + l.link->bytes_from_target();
+   return result;
+}
+
+void loopback_network::record_arrival( const fc::ripemd160& id, bool is_block )
+{
+   auto itr = _origin_times.find( id );
+   if( itr == _origin_times.end() )
+      return;
+   ( is_block ? _block_latencies : _transaction_latencies ).push_back( fc::time_point::now() - itr->second );
+}
+
+} } // graphene::net
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/net/node.hpp>
+
+#include <fc/network/tcp_socket.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <atomic>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace graphene { namespace net {
+
+/// Impairments applied to the data flowing through a link, in each direction
+struct link_conditions
+{
+   /// Delay added to every chunk of data
+   fc::microseconds latency;
+   /// Bytes per second, 0 for unlimited
+   uint64_t         bandwidth = 0;
+   /// Probability that a chunk of data is lost
+   double           loss_rate = 0;
+   /// Delay added to a lost chunk and the data queued behind it, as TCP would recover it by retransmission
+   fc::microseconds retransmit_delay = fc::milliseconds(200);
+};
+
+/**
+ * A TCP relay on the loopback interface which forwards connections to a target endpoint,
+ * delaying the data according to the link conditions. Data is relayed in userspace, so no
+ * privileges or traffic control setup are needed.
+ */
+class impaired_link
+{
+public:
+   impaired_link( fc::thread& relay_thread, const fc::ip::endpoint& target, const link_conditions& conditions,
+                  uint32_t seed );
+   ~impaired_link();
+
+   /// The endpoint to connect to instead of the target
+   fc::ip::endpoint endpoint()const { return _endpoint; }
+
+   /// Bytes relayed towards the target
+   uint64_t bytes_to_target()const { return _bytes_to_target; }
+   /// Bytes relayed from the target
+   uint64_t bytes_from_target()const { return _bytes_from_target; }
+
+private:
+   struct direction;
+   void accept_loop();
+   void relay( std::shared_ptr<fc::tcp_socket> client );
+   void read_loop( std::shared_ptr<direction> dir );
+   void write_loop( std::shared_ptr<direction> dir );
+   bool lose_chunk();
+
+   fc::thread&                     _relay_thread;
+   const fc::ip::endpoint          _target;
+   const link_conditions           _conditions;
+   uint32_t                        _random_state;
+   fc::tcp_server                  _server;
+   fc::ip::endpoint                _endpoint;
+   fc::future<void>                _accept_done;
+   std::vector<fc::future<void>>   _pumps_done;
+   std::atomic<uint64_t>           _bytes_to_target{0};
+   std::atomic<uint64_t>           _bytes_from_target{0};
+};
+
+/**
+ * A network of real @ref node instances on the loopback interface, connected through impaired links.
+ * Each node has a minimal delegate which accepts any block extending its chain, so the measurements
+ * cover the p2p code only. Nodes do not advertise peers and are limited to the connections set up
+ * by the network, so the topology is the one configured.
+ *
+ * Delegate calls run on the thread which created the network, which must yield (e.g. with fc::usleep)
+ * for the nodes to make progress.
+ */
+class loopback_network
+{
+public:
+   explicit loopback_network( uint32_t node_count );
+   ~loopback_network();
+
+   /// Add a link, over which node @p from connects to node @p to. Must be called before @ref start.
+   void connect( uint32_t from, uint32_t to, const link_conditions& conditions );
+   /// Connect each node to the next one
+   void connect_ring( const link_conditions& conditions );
+   /// Connect each node to @p degree other random nodes, in addition to a ring which keeps the network connected
+   void connect_random( uint32_t degree, const link_conditions& conditions, uint32_t seed );
+
+   /// Start the nodes, except those to be started later with @ref start_node
+   void start( const std::set<uint32_t>& delayed_nodes = std::set<uint32_t>() );
+   void start_node( uint32_t n );
+   /// Wait until every started node has all of its links connected
+   bool wait_for_connections( fc::microseconds timeout );
+
+   /// Append @p count blocks to the chain of node @p n without broadcasting them
+   void preload_blocks( uint32_t n, uint32_t count );
+   /// Produce a block on node @p n and broadcast it
+   block_id_type produce_block( uint32_t n, const std::vector<signed_transaction>& transactions = {} );
+   /// Broadcast a transaction from node @p n
+   void broadcast_transaction( uint32_t n, const signed_transaction& trx );
+
+   /// Wait until every started node has the block
+   bool wait_for_block( const block_id_type& id, fc::microseconds timeout );
+   /// Wait until every started node has received @p count transactions
+   bool wait_for_transactions( uint64_t count, fc::microseconds timeout );
+
+   uint32_t size()const { return _nodes.size(); }
+   uint32_t head_block_num( uint32_t n )const;
+   const node_ptr& get_node( uint32_t n )const;
+
+   /// Delays between an item being produced and its arrival at each of the other nodes
+   ///@{
+   const std::vector<fc::microseconds>& block_latencies()const { return _block_latencies; }
+   const std::vector<fc::microseconds>& transaction_latencies()const { return _transaction_latencies; }
+   void clear_latencies();
+   ///@}
+
+   /// Bytes relayed over the links of node @p n, in both directions
+   uint64_t bytes_of_node( uint32_t n )const;
+
+private:
+   class delegate;
+   struct node_info;
+   struct link_info
+   {
+      uint32_t                         from;
+      uint32_t                         to;
+      link_conditions                  conditions;
+      std::unique_ptr<impaired_link>   link;
+   };
+
+   bool is_started( uint32_t n )const;
+   void dial_links();
+   void record_arrival( const fc::ripemd160& id, bool is_block );
+
+   fc::thread                                _relay_thread;
+   std::vector<std::shared_ptr<node_info>>   _nodes;
+   std::vector<link_info>                    _links;
+   std::map<fc::ripemd160, fc::time_point>   _origin_times;
+   std::vector<fc::microseconds>             _block_latencies;
+   std::vector<fc::microseconds>             _transaction_latencies;
+   fc::time_point_sec                        _genesis_time;
+};
+
+} } // graphene::net
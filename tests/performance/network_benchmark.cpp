@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/protocol/transfer.hpp>
+
+#include <graphene/net/snapshot_unordered_set.hpp>
+
+#include "../common/loopback_network.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace graphene::net;
+using graphene::protocol::signed_transaction;
+using graphene::protocol::transfer_operation;
+
+namespace {
+
+link_conditions wan_link()
+{
+   link_conditions result;
+   result.latency = fc::milliseconds(50);
+   result.bandwidth = 1024 * 1024;
+   result.loss_rate = 0.01;
+   return result;
+}
+
+void log_percentiles( const std::string& what, std::vector<fc::microseconds> samples )
+{
+   if( samples.empty() )
+   {
+      wlog( "${w}: no samples", ("w",what) );
+      return;
+   }
+   std::sort( samples.begin(), samples.end() );
+   auto at = [&samples]( uint32_t percent ) {
+      return samples[ std::min<size_t>( samples.size() - 1, samples.size() * percent / 100 ) ].count() / 1000;
+   };
+   wlog( "${w}: p50 ${p50}ms, p90 ${p90}ms, p99 ${p99}ms, max ${max}ms over ${n} arrivals",
+         ("w",what)("p50",at(50))("p90",at(90))("p99",at(99))("max",samples.back().count()/1000)
+         ("n",samples.size()) );
+}
+
+signed_transaction make_transaction( uint32_t i )
+{
+   signed_transaction trx;
+   trx.ref_block_prefix = i;
+   trx.expiration = fc::time_point::now() + fc::minutes(10);
+   transfer_operation op;
+   op.amount.amount = i + 1;
+   trx.operations.push_back( op );
+   return trx;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( network_benchmarks )
+
+BOOST_AUTO_TEST_CASE( block_propagation_benchmark )
+{ try {
+   const uint32_t node_count = 20;
+   const uint32_t blocks = 50;
+   loopback_network network( node_count );
+   network.connect_random( 3, wan_link(), 1 );
+   network.start();
+   BOOST_REQUIRE( network.wait_for_connections( fc::seconds(30) ) );
+
+   for( uint32_t i = 0; i < blocks; ++i )
+   {
+      std::vector<signed_transaction> transactions;
+      for( uint32_t t = 0; t < 100; ++t )
+         transactions.push_back( make_transaction( i * 100 + t ) );
+      const block_id_type id = network.produce_block( i % node_count, transactions );
+      BOOST_REQUIRE( network.wait_for_block( id, fc::seconds(30) ) );
+   }
+   log_percentiles( "Block propagation to " + std::to_string( node_count ) + " nodes", network.block_latencies() );
+   wlog( "Call statistics of node 0: ${s}", ("s",network.get_node(0)->get_call_statistics()) );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( sync_throughput_benchmark )
+{ try {
+   const uint32_t node_count = 4;
+   const uint32_t blocks = 10000;
+   loopback_network network( node_count );
+   network.connect_ring( wan_link() );
+   network.preload_blocks( 0, blocks );
+   network.start( { node_count - 1 } );
+   BOOST_REQUIRE( network.wait_for_connections( fc::seconds(30) ) );
+
+   // let the first nodes catch up, then sync the last one from its two neighbours
+   auto start = fc::time_point::now();
+   for( uint32_t n = 0; n < node_count - 1; ++n )
+      while( network.head_block_num( n ) < blocks && fc::time_point::now() - start < fc::minutes(5) )
+         fc::usleep( fc::milliseconds(10) );
+   for( uint32_t n = 0; n < node_count - 1; ++n )
+      BOOST_REQUIRE_EQUAL( network.head_block_num( n ), blocks );
+
+   start = fc::time_point::now();
+   network.start_node( node_count - 1 );
+   while( network.head_block_num( node_count - 1 ) < blocks && fc::time_point::now() - start < fc::minutes(5) )
+      fc::usleep( fc::milliseconds(10) );
+   auto end = fc::time_point::now();
+   BOOST_REQUIRE_EQUAL( network.head_block_num( node_count - 1 ), blocks );
+   wlog( "Synced ${n} blocks at ${bps} blocks/s", ("n",blocks)("bps",uint64_t(blocks)*1000000/(end-start).count()) );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( transaction_gossip_benchmark )
+{ try {
+   const uint32_t node_count = 20;
+   const uint32_t transactions = 2000;
+   loopback_network network( node_count );
+   network.connect_random( 3, wan_link(), 2 );
+   network.start();
+   BOOST_REQUIRE( network.wait_for_connections( fc::seconds(30) ) );
+
+   uint64_t bytes_before = 0;
+   for( uint32_t n = 0; n < node_count; ++n )
+      bytes_before += network.bytes_of_node( n );
+   const auto start = fc::time_point::now();
+   for( uint32_t i = 0; i < transactions; ++i )
+      network.broadcast_transaction( i % node_count, make_transaction( i ) );
+   BOOST_REQUIRE( network.wait_for_transactions( transactions, fc::minutes(2) ) );
+   const auto elapsed = fc::time_point::now() - start;
+
+   uint64_t bytes = 0;
+   for( uint32_t n = 0; n < node_count; ++n )
+      bytes += network.bytes_of_node( n );
+   // every link is counted by both of its nodes
+   bytes = ( bytes - bytes_before ) / 2;
+   log_percentiles( "Transaction propagation", network.transaction_latencies() );
+   wlog( "Gossiped ${n} transactions in ${t}ms: ${b} bytes per transaction on the network, ${r} bytes/s per node",
+         ("n",transactions)("t",elapsed.count()/1000)("b",bytes/transactions)
+         ("r",bytes*2*1000000/elapsed.count()/node_count) );
+   wlog( "Usage of node 0: ${s}", ("s",network.get_node(0)->network_get_usage_stats()) );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( peer_set_benchmark )
+{ try {
+   // readers walk all peers as a broadcast does, while a writer connects and disconnects peers
+   const uint32_t peers = 500;
+   const uint32_t readers = 4;
+   const uint32_t iterations = 20000;
+   using peer_ptr = std::shared_ptr<uint64_t>;
+   std::vector<peer_ptr> all_peers;
+   for( uint32_t i = 0; i < peers + 100; ++i )
+      all_peers.push_back( std::make_shared<uint64_t>( i ) );
+
+   auto run = [&]( const std::string& name, std::function<uint64_t()> iterate, std::function<void(uint32_t)> churn ) {
+      std::atomic<bool> done{ false };
+      std::thread writer( [&]() {
+         for( uint32_t i = 0; !done; ++i )
+         {
+            churn( i );
+            std::this_thread::sleep_for( std::chrono::microseconds(100) );
+         }
+      });
+      const auto start = fc::time_point::now();
+      std::atomic<uint64_t> total{ 0 };
+      std::vector<std::thread> threads;
+      for( uint32_t r = 0; r < readers; ++r )
+         threads.emplace_back( [&]() {
+            uint64_t sum = 0;
+            for( uint32_t i = 0; i < iterations; ++i )
+               sum += iterate();
+            total += sum;
+         });
+      for( auto& t : threads )
+         t.join();
+      const auto elapsed = fc::time_point::now() - start;
+      done = true;
+      writer.join();
+      BOOST_CHECK( total > 0 );
+      wlog( "${n}: ${r} iterations over ${p} peers per second",
+            ("n",name)("r",uint64_t(readers)*iterations*1000000/elapsed.count())("p",peers) );
+   };
+
+   // a set guarded by a mutex, to be held while iterating
+   {
+      std::unordered_set<peer_ptr> locked_set( all_peers.begin(), all_peers.begin() + peers );
+      std::mutex mutex;
+      run( "Locked set", [&]() {
+         std::lock_guard<std::mutex> lock( mutex );
+         uint64_t sum = 0;
+         for( const peer_ptr& p : locked_set )
+            sum += *p;
+         return sum;
+      }, [&]( uint32_t i ) {
+         std::lock_guard<std::mutex> lock( mutex );
+         locked_set.erase( all_peers[ i % all_peers.size() ] );
+         locked_set.insert( all_peers[ ( i + peers ) % all_peers.size() ] );
+      });
+   }
+
+   // a snapshot set, which locks only while copying the pointer to the current contents, not while iterating
+   {
+      snapshot_unordered_set<peer_ptr> snapshot_set;
+      for( uint32_t i = 0; i < peers; ++i )
+         snapshot_set.insert( all_peers[i] );
+      run( "Snapshot set", [&]() {
+         uint64_t sum = 0;
+         for( const peer_ptr& p : snapshot_set.get_snapshot() )
+            sum += *p;
+         return sum;
+      }, [&]( uint32_t i ) {
+         snapshot_set.erase( all_peers[ i % all_peers.size() ] );
+         snapshot_set.insert( all_peers[ ( i + peers ) % all_peers.size() ] );
+      });
+   }
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,17 +24,26 @@
 
 #include "../common/init_unit_test_suite.hpp"
 
+#include <graphene/app/api.hpp>
+
 #include <graphene/chain/database.hpp>
 
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/hardfork.hpp>
+#include <graphene/chain/market_object.hpp>
 #include <graphene/chain/proposal_object.hpp>
+#include <graphene/chain/vesting_balance_object.hpp>
+#include <graphene/chain/withdraw_permission_object.hpp>
 
 #include <graphene/db/simple_index.hpp>
 
+#include <fc/asio.hpp>
 #include <fc/crypto/digest.hpp>
 
 #include "../common/database_fixture.hpp"
+
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -56,6 +65,38 @@ BOOST_AUTO_TEST_CASE( sigcheck_benchmark )
    wlog( "Benchmark: verify ${sps} signatures/s", ("sps",(cycles*1000000)/elapsed.count()) );
 }
 
+BOOST_AUTO_TEST_CASE( parallel_sigcheck_benchmark )
+{
+   // blocks of transactions with uneven numbers of signatures, as recovered by precompute_parallel()
+   vector<fc::ecc::private_key> keys;
+   for( uint32_t i = 0; i < 10; ++i )
+      keys.push_back( generate_private_key( "sigcheck" + std::to_string(i) ) );
+   signed_block block;
+   uint64_t signatures = 0;
+   for( uint32_t i = 0; i < 10000; ++i )
+   {
+      signed_transaction trx;
+      transfer_operation op;
+      op.to = account_id_type(1);
+      op.amount = asset( i + 1 );
+      trx.operations.push_back( op );
+      trx.set_expiration( db.head_block_time() + fc::minutes(1) );
+      const uint32_t count = ( i % 50 == 0 ) ? keys.size() : 1;
+      for( uint32_t k = 0; k < count; ++k )
+         trx.sign( keys[k], db.get_chain_id() );
+      signatures += count;
+      block.transactions.emplace_back( trx );
+   }
+
+   const uint32_t threads = fc::asio::default_io_service_scope::get_num_threads();
+   auto start = fc::time_point::now();
+   db.precompute_parallel( block, database::skip_witness_signature | database::skip_merkle_check ).wait();
+   auto elapsed = fc::time_point::now() - start;
+   wlog( "Benchmark: recover ${sps} signatures/s with ${t} threads, ${spc} signatures/s per thread",
+         ("sps",signatures*1000000/elapsed.count())("t",threads)
+         ("spc",signatures*1000000/elapsed.count()/threads) );
+}
+
 // See https://bitshares.org/blog/2015/06/08/measuring-performance/
 // (note this is not the original test mentioned in the above post, but was
 //  recreated later according to the description)
@@ -208,4 +249,492 @@ BOOST_AUTO_TEST_CASE( one_hundred_k_benchmark )
    db._undo_db.enable();
 } FC_LOG_AND_RETHROW() }
 
+
+BOOST_AUTO_TEST_CASE( asset_holders_benchmark )
+{ try {
+   graphene::app::asset_api asset_api( app );
+   const asset_object& test = create_user_issued_asset( "HOLDERS" );
+   const asset_id_type test_id = test.id;
+   const string test_name = "HOLDERS";
+
+   vector<account_id_type> owners;
+   for( const account_object& acct : db.get_index_type<account_index>().indices() )
+      owners.push_back( acct.id );
+
+   db._undo_db.disable();
+   const uint32_t holders = 2000000;
+   auto start = fc::time_point::now();
+   for( uint32_t i = 0; i < holders; ++i )
+   {
+      // balances are distinct, so owners can be reused without violating uniqueness of by_asset_balance
+      db.create<account_balance_object>( [&owners,test_id,i]( account_balance_object& b ) {
+         b.owner = owners[ i % owners.size() ];
+         b.asset_type = test_id;
+         b.balance = i + 1;
+      });
+   }
+   auto end = fc::time_point::now();
+   wlog( "Created ${n} balances in ${t}ms", ("n",holders)("t",(end-start).count()/1000) );
+
+   start = fc::time_point::now();
+   const auto& bal_idx = db.get_index_type< primary_index< account_balance_index > >()
+                           .get_secondary_index< balances_by_asset_index >().get_balances_by_asset();
+   end = fc::time_point::now();
+   wlog( "Ordered ${n} balances by amount in ${t}ms", ("n",holders)("t",(end-start).count()/1000) );
+
+   start = fc::time_point::now();
+   const auto range = bal_idx.equal_range( boost::make_tuple( test_id ) );
+   const auto linear_count = std::distance( range.first, range.second );
+   end = fc::time_point::now();
+   wlog( "Linear count of ${n} holders: ${t}us", ("n",linear_count)("t",(end-start).count()) );
+   BOOST_CHECK_EQUAL( linear_count, holders );
+
+   const uint32_t cycles = 1000;
+   start = fc::time_point::now();
+   for( uint32_t i = 0; i < cycles; ++i )
+      BOOST_REQUIRE_EQUAL( asset_api.get_asset_holders_count( test_name ), int(holders) - 1 );
+   end = fc::time_point::now();
+   wlog( "get_asset_holders_count: ${t}us per call", ("t",(end-start).count()/cycles) );
+
+   start = fc::time_point::now();
+   for( uint32_t i = 0; i < cycles; ++i )
+   {
+      auto page = asset_api.get_asset_holders( test_name, holders - 100, 100 );
+      BOOST_REQUIRE_EQUAL( page.size(), 100u );
+      BOOST_REQUIRE_EQUAL( page.front().amount.value, 100 );
+      BOOST_REQUIRE_EQUAL( page.back().amount.value, 1 );
+   }
+   end = fc::time_point::now();
+   wlog( "get_asset_holders at offset ${o}: ${t}us per call", ("o",holders-100)("t",(end-start).count()/cycles) );
+
+   start = fc::time_point::now();
+   asset_api.get_all_asset_holders();
+   end = fc::time_point::now();
+   wlog( "get_all_asset_holders: ${t}us", ("t",(end-start).count()) );
+
+   db._undo_db.enable();
+} FC_LOG_AND_RETHROW() }
+
+// Compares id lookups through the dense id tables with lookups in the ordered by_id index
+BOOST_AUTO_TEST_CASE( object_lookup_benchmark )
+{ try {
+   ACTORS( (alice) );
+   db._undo_db.disable();
+   const uint32_t objects = 1000000;
+   for( uint32_t i = 0; i < objects; ++i )
+      db.create<vesting_balance_object>( [alice_id]( vesting_balance_object& vbo ) {
+         vbo.owner = alice_id;
+         vbo.balance = asset( 1 );
+      });
+   db._undo_db.enable();
+
+   const auto& by_id = db.get_index_type<vesting_balance_index>().indices().get<by_id>();
+   const uint64_t lookups = 10000000;
+   int64_t tree_sum = 0;
+   auto start = fc::time_point::now();
+   for( uint64_t i = 0; i < lookups; ++i )
+      tree_sum += by_id.find( vesting_balance_id_type( ( i * 7919 ) % objects ) )->balance.amount.value;
+   auto end = fc::time_point::now();
+   wlog( "Ordered index: ${n} vesting balance lookups/s", ("n",lookups*1000000/(end-start).count()) );
+
+   int64_t direct_sum = 0;
+   start = fc::time_point::now();
+   for( uint64_t i = 0; i < lookups; ++i )
+      direct_sum += vesting_balance_id_type( ( i * 7919 ) % objects )(db).balance.amount.value;
+   end = fc::time_point::now();
+   wlog( "database::get: ${n} vesting balance lookups/s", ("n",lookups*1000000/(end-start).count()) );
+   BOOST_CHECK_EQUAL( tree_sum, direct_sum );
+} FC_LOG_AND_RETHROW() }
+
+// Balance lookups and adjustments, as done by every transfer, through the cached balances index
+BOOST_AUTO_TEST_CASE( balance_adjust_benchmark )
+{ try {
+   db._undo_db.disable();
+   const uint32_t accounts = 10000;
+   vector<share_type> initial_balances;
+   for( uint32_t i = 0; i < accounts; ++i )
+   {
+      initial_balances.push_back( db.get_balance( account_id_type(i), asset_id_type() ).amount );
+      db.adjust_balance( account_id_type(i), asset( 1000000 ) );
+   }
+
+   const uint64_t transfers = 2000000;
+   auto start = fc::time_point::now();
+   for( uint64_t i = 0; i < transfers; ++i )
+   {
+      const account_id_type from( ( i * 7919 ) % accounts );
+      const account_id_type to( ( i * 104729 + 1 ) % accounts );
+      db.adjust_balance( from, -asset( 1 ) );
+      db.adjust_balance( to, asset( 1 ) );
+   }
+   auto end = fc::time_point::now();
+   wlog( "adjust_balance: ${n} transfers/s", ("n",transfers*1000000/(end-start).count()) );
+
+   int64_t total = 0;
+   start = fc::time_point::now();
+   for( uint64_t i = 0; i < transfers; ++i )
+      total += db.get_balance( account_id_type( ( i * 7919 ) % accounts ), asset_id_type() ).amount.value;
+   end = fc::time_point::now();
+   wlog( "get_balance: ${n} lookups/s", ("n",transfers*1000000/(end-start).count()) );
+   BOOST_CHECK_GT( total, 0 );
+
+   // Give back the extra supply
+   for( uint32_t i = 0; i < accounts; ++i )
+      db.adjust_balance( account_id_type(i),
+                         asset( initial_balances[i] - db.get_balance( account_id_type(i), asset_id_type() ).amount ) );
+   db._undo_db.enable();
+} FC_LOG_AND_RETHROW() }
+
+// The maintenance block updates the statistics of every account whose core balance changed in the interval
+BOOST_AUTO_TEST_CASE( maintenance_flag_benchmark )
+{ try {
+   const fc::ecc::private_key key = generate_private_key( "maintenance" );
+   const uint32_t accounts = 100000;
+   vector<account_id_type> ids;
+   ids.reserve( accounts );
+
+   db._undo_db.disable();
+   account_create_operation aco;
+   aco.registrar = account_id_type();
+   aco.owner = authority( 1, public_key_type( key.get_public_key() ), 1 );
+   aco.active = aco.owner;
+   aco.options.memo_key = key.get_public_key();
+   aco.options.voting_account = GRAPHENE_PROXY_TO_SELF_ACCOUNT;
+   aco.fee = db.current_fee_schedule().calculate_fee( aco );
+   for( uint32_t i = 0; i < accounts; ++i )
+   {
+      aco.name = "m" + fc::to_string(i);
+      trx.clear();
+      test::set_expiration( db, trx );
+      trx.operations.push_back( aco );
+      ids.push_back( db.apply_transaction( trx, ~0 ).operation_results[0].get<object_id_type>() );
+   }
+   trx.clear();
+   db._undo_db.enable();
+   generate_blocks( db.get_dynamic_global_properties().next_maintenance_time );
+
+   // flag the core balance of every account
+   for( const account_id_type& id : ids )
+      db.adjust_balance( id, asset( 1 ) );
+
+   auto start = fc::time_point::now();
+   generate_block();
+   auto end = fc::time_point::now();
+   wlog( "Ordinary block: ${t}us", ("t",(end-start).count()) );
+
+   start = fc::time_point::now();
+   generate_blocks( db.get_dynamic_global_properties().next_maintenance_time );
+   end = fc::time_point::now();
+   wlog( "Maintenance block with ${n} flagged balances: ${t}ms", ("n",accounts)("t",(end-start).count()/1000) );
+   BOOST_CHECK_EQUAL( ids.back()(db).statistics(db).core_in_balance.value, 1 );
+
+   for( const account_id_type& id : ids )
+      db.adjust_balance( id, -asset( 1 ) );
+} FC_LOG_AND_RETHROW() }
+
+// Approving thousands of open multisig proposals one signer at a time, as exchange cold wallets do
+BOOST_AUTO_TEST_CASE( proposal_approval_benchmark )
+{ try {
+   ACTORS( (alice)(bob)(carol)(wallet) );
+   fund( alice, asset( 100000000000LL ) );
+   fund( wallet, asset( 100000000 ) );
+   db.modify( wallet_id(db), [&]( account_object& a ) {
+      a.active = authority( 3, alice_id, 1, bob_id, 1, carol_id, 1 );
+   });
+
+   db._undo_db.disable();
+   const uint32_t proposals = 5000;
+   vector<proposal_id_type> ids;
+   ids.reserve( proposals );
+   for( uint32_t i = 0; i < proposals; ++i )
+   {
+      transfer_operation top;
+      top.from = wallet_id;
+      top.to = alice_id;
+      top.amount = asset( 1 + i );
+      proposal_create_operation pop;
+      pop.fee_paying_account = alice_id;
+      pop.expiration_time = db.head_block_time() + fc::days(1);
+      pop.proposed_ops.emplace_back( top );
+      trx.clear();
+      test::set_expiration( db, trx );
+      trx.operations.push_back( pop );
+      for( auto& op : trx.operations )
+         db.current_fee_schedule().set_fee( op );
+      ids.push_back( db.apply_transaction( trx, ~0 ).operation_results[0].get<object_id_type>() );
+   }
+
+   const auto approve_all = [&]( account_id_type approver ) {
+      proposal_update_operation uop;
+      uop.fee_paying_account = alice_id;
+      uop.active_approvals_to_add.insert( approver );
+      uop.fee = db.current_fee_schedule().calculate_fee( uop );
+      const auto start = fc::time_point::now();
+      for( const proposal_id_type& id : ids )
+      {
+         uop.proposal = id;
+         trx.clear();
+         test::set_expiration( db, trx );
+         trx.operations.push_back( uop );
+         db.apply_transaction( trx, ~0 );
+      }
+      const auto end = fc::time_point::now();
+      wlog( "${n} proposal approvals/s by ${a}", ("n",uint64_t(proposals)*1000000/(end-start).count())("a",approver) );
+   };
+   approve_all( alice_id );
+   approve_all( bob_id );
+   BOOST_CHECK_EQUAL( db.get_index_type<proposal_index>().indices().size(), proposals );
+   // the last approval executes every proposal
+   approve_all( carol_id );
+   BOOST_CHECK_EQUAL( db.get_index_type<proposal_index>().indices().size(), 0u );
+
+   trx.clear();
+   db._undo_db.enable();
+} FC_LOG_AND_RETHROW() }
+
+// Compares database::modify with the typed modify_in, with and without re-checking the index orderings
+BOOST_AUTO_TEST_CASE( typed_modify_benchmark )
+{ try {
+   using order_primary_index = primary_index< limit_order_index >;
+   db._undo_db.disable();
+   const uint32_t orders = 100000;
+   vector<const limit_order_object*> all_orders;
+   all_orders.reserve( orders );
+   for( uint32_t i = 0; i < orders; ++i )
+      all_orders.push_back( &db.create<limit_order_object>( [i]( limit_order_object& o ) {
+         o.seller = account_id_type( i % 1000 );
+         o.for_sale = 1000000000;
+         o.sell_price = price( asset( 1000 + i ), asset( 1000, asset_id_type(1) ) );
+         o.expiration = fc::time_point_sec( 1000000 + i );
+      }) );
+
+   const uint64_t modifications = 5000000;
+   const auto fill = []( limit_order_object& o ) { o.for_sale -= 1; };
+   auto start = fc::time_point::now();
+   for( uint64_t i = 0; i < modifications; ++i )
+      db.modify( *all_orders[ ( i * 7919 ) % orders ], fill );
+   auto end = fc::time_point::now();
+   wlog( "database::modify: ${n} modifications/s", ("n",modifications*1000000/(end-start).count()) );
+
+   start = fc::time_point::now();
+   for( uint64_t i = 0; i < modifications; ++i )
+      db.modify_in< order_primary_index >( *all_orders[ ( i * 7919 ) % orders ], fill );
+   end = fc::time_point::now();
+   wlog( "database::modify_in: ${n} modifications/s", ("n",modifications*1000000/(end-start).count()) );
+
+   start = fc::time_point::now();
+   for( uint64_t i = 0; i < modifications; ++i )
+      db.modify_in< order_primary_index >( *all_orders[ ( i * 7919 ) % orders ], fill, true );
+   end = fc::time_point::now();
+   wlog( "database::modify_in with keys unchanged: ${n} modifications/s",
+         ("n",modifications*1000000/(end-start).count()) );
+
+   int64_t total = 0;
+   for( const auto* o : all_orders )
+      total += o->for_sale.value;
+   BOOST_CHECK_EQUAL( total, int64_t(orders) * 1000000000 - 3 * int64_t(modifications) );
+
+   for( const auto* o : all_orders )
+      db.remove( *o );
+   db._undo_db.enable();
+} FC_LOG_AND_RETHROW() }
+
+// Margin call checks on every feed update, with many call and limit orders that cannot match
+BOOST_AUTO_TEST_CASE( call_order_check_benchmark )
+{ try {
+   generate_blocks( HARDFORK_CORE_2481_TIME );
+   set_expiration( db, trx );
+   ACTORS( (feeder) );
+
+   const uint32_t assets = 25;
+   const uint32_t borrowers = 200;
+   vector<asset_id_type> mpas;
+   for( uint32_t i = 0; i < assets; ++i )
+   {
+      const asset_object& mpa = create_bitasset( "MPA" + string( 1, char('A' + i) ), feeder_id );
+      mpas.push_back( mpa.id );
+      update_feed_producers( mpa, { feeder_id } );
+   }
+
+   price_feed feed;
+   feed.maintenance_collateral_ratio = 1750;
+   feed.maximum_short_squeeze_ratio = 1100;
+   for( const asset_id_type& mpa : mpas )
+   {
+      feed.settlement_price = mpa(db).amount( 1 ) / asset( 5 );
+      publish_feed( mpa(db), feeder, feed );
+   }
+
+   // every borrower has a call order and a limit order above the feed in every market
+   for( uint32_t i = 0; i < borrowers; ++i )
+   {
+      const account_object& borrower = create_account( "b" + fc::to_string(i) );
+      fund( borrower, asset( 100000000 ) );
+      for( const asset_id_type& mpa : mpas )
+      {
+         borrow( borrower, mpa(db).amount( 1000 ), asset( 15000 + 10 * i ) );
+         create_sell_order( borrower, mpa(db).amount( 10 ), asset( 60 + i ) );
+      }
+   }
+   generate_block();
+   set_expiration( db, trx );
+
+   const uint32_t rounds = 1000;
+   auto start = fc::time_point::now();
+   for( uint32_t r = 0; r < rounds; ++r )
+   {
+      for( const asset_id_type& mpa : mpas )
+      {
+         const asset_object& a = mpa(db);
+         BOOST_REQUIRE( !db.check_call_orders( a, true, false, &a.bitasset_data(db) ) );
+      }
+   }
+   auto end = fc::time_point::now();
+   wlog( "${n} call order checks/s over ${c} call orders per asset",
+         ("n",uint64_t(rounds)*assets*1000000/(end-start).count())("c",borrowers) );
+
+   // feeds moving within the protected range
+   const uint32_t feed_rounds = 20;
+   start = fc::time_point::now();
+   for( uint32_t r = 0; r < feed_rounds; ++r )
+   {
+      for( const asset_id_type& mpa : mpas )
+      {
+         feed.settlement_price = mpa(db).amount( 100 ) / asset( 500 + r % 2 );
+         publish_feed( mpa(db), feeder, feed );
+      }
+   }
+   end = fc::time_point::now();
+   wlog( "${n} feed publications/s", ("n",uint64_t(feed_rounds)*assets*1000000/(end-start).count()) );
+   BOOST_CHECK_EQUAL( db.get_index_type<call_order_index>().indices().size(), assets * borrowers );
+} FC_LOG_AND_RETHROW() }
+
+// Bursts of exchanges against the same liquidity pools, with the latency of each exchange
+BOOST_AUTO_TEST_CASE( liquidity_pool_exchange_benchmark )
+{ try {
+   generate_blocks( HARDFORK_LIQUIDITY_POOL_TIME );
+   set_expiration( db, trx );
+   ACTORS( (maker)(trader) );
+   fund( maker, asset( 100000000000LL ) );
+   fund( trader, asset( 100000000000LL ) );
+
+   const uint32_t pools = 100;
+   vector<liquidity_pool_id_type> pool_ids;
+   vector<asset_id_type> pool_assets;
+   for( uint32_t i = 0; i < pools; ++i )
+   {
+      const string suffix = string( 1, char('A' + i / 26) ) + char('A' + i % 26);
+      const asset_object& uia = create_user_issued_asset( "SWAP" + suffix );
+      const asset_object& share = create_user_issued_asset( "LPS" + suffix, maker, charge_market_fee );
+      issue_uia( maker, uia.amount( 1000000000 ) );
+      issue_uia( trader, uia.amount( 1000000000 ) );
+      liquidity_pool_id_type pool_id = create_liquidity_pool( maker_id, asset_id_type(), uia.id, share.id, 20, 0 ).id;
+      deposit_to_liquidity_pool( maker_id, pool_id, asset( 1000000000 ), uia.amount( 1000000000 ) );
+      pool_ids.push_back( pool_id );
+      pool_assets.push_back( uia.id );
+   }
+
+   db._undo_db.disable();
+   const uint32_t swaps = 200000;
+   vector<int64_t> latencies;
+   latencies.reserve( swaps );
+   liquidity_pool_exchange_operation op;
+   op.account = trader_id;
+   op.fee = db.current_fee_schedule().calculate_fee( op );
+   const auto start = fc::time_point::now();
+   for( uint32_t i = 0; i < swaps; ++i )
+   {
+      // arbitrage-like bursts: several swaps in a row against the same pool, alternating the direction
+      const uint32_t p = ( i / 8 ) % pools;
+      op.pool = pool_ids[p];
+      op.amount_to_sell = ( i % 2 == 0 ) ? asset( 1000 ) : asset( 1000, pool_assets[p] );
+      op.min_to_receive = ( i % 2 == 0 ) ? asset( 1, pool_assets[p] ) : asset( 1 );
+      trx.clear();
+      test::set_expiration( db, trx );
+      trx.operations.push_back( op );
+      const auto swap_start = fc::time_point::now();
+      db.apply_transaction( trx, ~0 );
+      latencies.push_back( ( fc::time_point::now() - swap_start ).count() );
+   }
+   const auto end = fc::time_point::now();
+   trx.clear();
+   db._undo_db.enable();
+
+   std::sort( latencies.begin(), latencies.end() );
+   wlog( "${n} liquidity pool exchanges/s over ${p} pools", ("n",uint64_t(swaps)*1000000/(end-start).count())("p",pools) );
+   wlog( "Exchange latency: median ${m}us, 99th percentile ${p}us, max ${x}us",
+         ("m",latencies[swaps/2])("p",latencies[swaps*99/100])("x",latencies.back()) );
+
+   const liquidity_pool_object& pool = pool_ids.front()(db);
+   BOOST_CHECK( pool.balance_a > 0 && pool.balance_b > 0 );
+   BOOST_CHECK( pool.virtual_value == fc::uint128_t( pool.balance_a.value ) * pool.balance_b.value );
+} FC_LOG_AND_RETHROW() }
+
+// Per-block housekeeping should cost in proportion to what is due, not to what is pending
+BOOST_AUTO_TEST_CASE( expiry_housekeeping_benchmark )
+{ try {
+   ACTORS( (alice) );
+   // every order sells 1 CORE, taken from alice's balance as limit_order_create does
+   fund( alice, asset( 2000000 ) );
+   const asset_id_type test_id = create_user_issued_asset( "EXPIRY" ).id;
+   generate_block();
+
+   db._undo_db.disable();
+   auto create_expiries = [this,alice_id,test_id]( uint32_t count, fc::time_point_sec expiration ) {
+      db.adjust_balance( alice_id, -asset( count ) );
+      db.modify( alice_id(db).statistics(db), [count]( account_statistics_object& s ) {
+         s.total_core_in_orders += count;
+      });
+      for( uint32_t i = 0; i < count; ++i )
+      {
+         db.create<limit_order_object>( [alice_id,test_id,expiration]( limit_order_object& o ) {
+            o.seller = alice_id;
+            o.for_sale = 1;
+            o.sell_price = price( asset( 1 ), asset( 1, test_id ) );
+            o.expiration = expiration;
+         });
+         db.create<withdraw_permission_object>( [this,alice_id,expiration]( withdraw_permission_object& p ) {
+            p.withdraw_from_account = alice_id;
+            p.authorized_account = account_id_type();
+            p.withdrawal_limit = asset( 1 );
+            p.withdrawal_period_sec = 86400;
+            p.period_start_time = db.head_block_time();
+            p.expiration = expiration;
+         });
+      }
+   };
+
+   const uint32_t pending = 1000000;
+   auto start = fc::time_point::now();
+   create_expiries( pending, db.head_block_time() + fc::days(365) );
+   auto end = fc::time_point::now();
+   wlog( "Created ${n} pending limit order and withdraw permission expiries in ${t}ms",
+         ("n",pending*2)("t",(end-start).count()/1000) );
+
+   const auto& limit_idx = db.get_index_type<limit_order_index>().indices();
+   const auto& permit_idx = db.get_index_type<withdraw_permission_index>().indices();
+
+   const uint32_t idle_blocks = 100;
+   start = fc::time_point::now();
+   for( uint32_t i = 0; i < idle_blocks; ++i )
+      generate_block();
+   end = fc::time_point::now();
+   wlog( "Block with nothing due: ${t}us", ("t",(end-start).count()/idle_blocks) );
+   BOOST_CHECK_EQUAL( limit_idx.size(), pending );
+   BOOST_CHECK_EQUAL( permit_idx.size(), pending );
+
+   for( uint32_t due : { 1000u, 10000u, 100000u } )
+   {
+      create_expiries( due, db.head_block_time() + db.get_global_properties().parameters.block_interval );
+      start = fc::time_point::now();
+      generate_block();
+      end = fc::time_point::now();
+      wlog( "Block with ${n} due: ${t}us", ("n",due*2)("t",(end-start).count()) );
+      BOOST_CHECK_EQUAL( limit_idx.size(), pending );
+      BOOST_CHECK_EQUAL( permit_idx.size(), pending );
+   }
+
+   db._undo_db.enable();
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
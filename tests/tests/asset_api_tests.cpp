@@ -59,6 +59,22 @@ BOOST_AUTO_TEST_CASE( asset_holders )
    BOOST_CHECK(holders[1].name == "bob");
    BOOST_CHECK(holders[2].name == "alice");
    BOOST_CHECK(holders[3].name == "dan");
+
+   // pages start at the given position
+   holders = asset_api.get_asset_holders( std::string( static_cast<object_id_type>(asset_id_type())), 2, 100);
+   BOOST_REQUIRE_EQUAL(holders.size(), 2u);
+   BOOST_CHECK(holders[0].name == "alice");
+   BOOST_CHECK(holders[1].name == "dan");
+   holders = asset_api.get_asset_holders( std::string( static_cast<object_id_type>(asset_id_type())), 1, 1);
+   BOOST_REQUIRE_EQUAL(holders.size(), 1u);
+   BOOST_CHECK(holders[0].name == "bob");
+   BOOST_CHECK(asset_api.get_asset_holders( std::string( static_cast<object_id_type>(asset_id_type())), 4, 100).empty());
+
+   // accounts whose balance went to zero are no holders
+   transfer(dan, account_id_type()(db), asset(100));
+   holders = asset_api.get_asset_holders( std::string( static_cast<object_id_type>(asset_id_type())), 0, 100);
+   BOOST_REQUIRE_EQUAL(holders.size(), 3u);
+   BOOST_CHECK(holders[2].name == "alice");
 }
 BOOST_AUTO_TEST_CASE( api_limit_get_asset_holders )
 {
@@ -2364,6 +2364,115 @@ BOOST_AUTO_TEST_CASE( self_approving_proposal )
    db.get<proposal_object>(pid1);
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( missing_approvals )
+{ try {
+   ACTORS( (alice)(bob)(carol)(wallet) );
+   fund( wallet );
+   // wallet is controlled by any two of alice, bob and carol's key
+   db.modify( wallet_id(db), [&]( account_object& a ) {
+      a.active = authority( 2, alice_id, 1, bob_id, 1, public_key_type( carol_private_key.get_public_key() ), 1 );
+   });
+
+   transfer_operation top;
+   top.from = wallet_id;
+   top.to = alice_id;
+   top.amount = asset(100);
+   const proposal_object& prop = db.create<proposal_object>( [&]( proposal_object& p ) {
+      p.expiration_time = db.head_block_time() + fc::days(1);
+      p.proposed_transaction.operations.push_back( top );
+      p.required_active_approvals.insert( wallet_id );
+   });
+   const auto set_approvals = [&]( flat_set<account_id_type> accounts, flat_set<public_key_type> keys ) {
+      db.modify( prop, [&]( proposal_object& p ) {
+         p.available_active_approvals = accounts;
+         p.available_key_approvals = keys;
+      });
+   };
+   const flat_set<account_id_type> only_wallet{ wallet_id };
+
+   BOOST_CHECK( prop.get_missing_approvals( db ) == only_wallet );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   set_approvals( { alice_id }, {} );
+   BOOST_CHECK( prop.get_missing_approvals( db ) == only_wallet );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   set_approvals( { alice_id }, { public_key_type( carol_private_key.get_public_key() ) } );
+   BOOST_CHECK( prop.get_missing_approvals( db ).empty() );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   // alice approves through her key, one level down
+   set_approvals( {}, { public_key_type( alice_private_key.get_public_key() ),
+                        public_key_type( carol_private_key.get_public_key() ) } );
+   BOOST_CHECK( prop.get_missing_approvals( db ).empty() );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   set_approvals( { wallet_id }, {} );
+   BOOST_CHECK( prop.get_missing_approvals( db ).empty() );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   // not every proposal without missing approvals is authorized: unused keys are rejected
+   set_approvals( { wallet_id }, { public_key_type( bob_private_key.get_public_key() ) } );
+   BOOST_CHECK( prop.get_missing_approvals( db ).empty() );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   db.remove( prop );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( missing_approvals_nested )
+{ try {
+   ACTORS( (alice)(carol)(dan)(xavier)(wallet) );
+   fund( wallet );
+   BOOST_REQUIRE_EQUAL( uint32_t( db.get_global_properties().parameters.max_authority_depth ), 2u );
+   // xavier is reached through alice within the depth limit and through carol and dan beyond it
+   db.modify( wallet_id(db), [&]( account_object& a ) {
+      a.active = authority( 2, alice_id, 1, carol_id, 1 );
+   });
+   db.modify( alice_id(db), [&]( account_object& a ) {
+      a.active = authority( 1, xavier_id, 1 );
+   });
+   db.modify( carol_id(db), [&]( account_object& a ) {
+      a.active = authority( 1, dan_id, 1 );
+   });
+   db.modify( dan_id(db), [&]( account_object& a ) {
+      a.active = authority( 1, xavier_id, 1 );
+   });
+
+   transfer_operation top;
+   top.from = wallet_id;
+   top.to = alice_id;
+   top.amount = asset(100);
+   const proposal_object& prop = db.create<proposal_object>( [&]( proposal_object& p ) {
+      p.expiration_time = db.head_block_time() + fc::days(1);
+      p.proposed_transaction.operations.push_back( top );
+      p.required_active_approvals.insert( wallet_id );
+   });
+
+   const flat_set<account_id_type> only_wallet{ wallet_id };
+   BOOST_CHECK( prop.get_missing_approvals( db ) == only_wallet );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   // dan's authority is checked at the depth limit, where xavier counts only because alice's check approved him
+   db.modify( prop, [&]( proposal_object& p ) {
+      p.available_key_approvals = { public_key_type( xavier_private_key.get_public_key() ) };
+   });
+   BOOST_CHECK( prop.get_missing_approvals( db ).empty() );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   // the temporary account is always approved
+   db.modify( carol_id(db), [&]( account_object& a ) {
+      a.active = authority( 1, GRAPHENE_TEMP_ACCOUNT, 1 );
+   });
+   db.modify( prop, [&]( proposal_object& p ) {
+      p.available_key_approvals.clear();
+      p.available_active_approvals = { alice_id };
+   });
+   BOOST_CHECK( prop.get_missing_approvals( db ).empty() );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   db.remove( prop );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE( self_deleting_proposal )
 { try {
    ACTORS( (alice) );
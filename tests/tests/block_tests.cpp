@@ -483,6 +483,78 @@ BOOST_AUTO_TEST_CASE( fork_blocks )
    }
 }
 
+BOOST_AUTO_TEST_CASE( fork_db_pruning )
+{
+   try {
+      auto make_block = []( const block_id_type& previous, uint32_t time ) {
+         signed_block b;
+         b.previous = previous;
+         b.timestamp = fc::time_point_sec( time ); // to distinguish blocks of different forks
+         return b;
+      };
+
+      fork_database fdb;
+      vector<signed_block> main_chain;
+      main_chain.push_back( make_block( block_id_type(), 1 ) );
+      for( uint32_t i = 1; i < 10; ++i )
+         main_chain.push_back( make_block( main_chain.back().id(), 1 + i ) );
+      for( const auto& b : main_chain )
+         fdb.push_block( b );
+
+      // a fork from block #2, and a fork from block #8
+      vector<signed_block> old_fork{ make_block( main_chain[1].id(), 1000 ) };
+      for( uint32_t i = 1; i < 5; ++i )
+         old_fork.push_back( make_block( old_fork.back().id(), 1000 + i ) );
+      for( const auto& b : old_fork )
+         fdb.push_block( b );
+      const signed_block new_fork = make_block( main_chain[7].id(), 2000 );
+      fdb.push_block( new_fork );
+
+      BOOST_CHECK_EQUAL( old_fork.back().block_num(), 7u );
+      BOOST_CHECK( fdb.head()->id == main_chain.back().id() );
+      BOOST_CHECK_EQUAL( fdb.size(), 16u );
+      BOOST_CHECK( fdb.memory_usage() > 0 );
+
+      // nothing is pruned without a memory limit, not even forks which lost their fork point
+      fdb.set_max_size( 5 );
+      BOOST_CHECK_EQUAL( fdb.size(), 10u );
+      fdb.prune_forks();
+      BOOST_CHECK_EQUAL( fdb.size(), 10u );
+      uint64_t usage = 0;
+      for( uint32_t i = 4; i < 10; ++i )
+         usage += fc::raw::pack_size( main_chain[i] );
+      for( uint32_t i = 2; i < 5; ++i )
+         usage += fc::raw::pack_size( old_fork[i] );
+      usage += fc::raw::pack_size( new_fork );
+      BOOST_CHECK_EQUAL( fdb.memory_usage(), usage );
+
+      // nor within the limit
+      fdb.set_max_memory( usage );
+      fdb.prune_forks();
+      BOOST_CHECK_EQUAL( fdb.size(), 10u );
+
+      // over the limit, the old fork goes first as it can never be switched to, which is enough here
+      fdb.set_max_memory( usage - 1 );
+      fdb.prune_forks();
+      BOOST_CHECK_EQUAL( fdb.size(), 7u );
+      BOOST_CHECK_EQUAL( fdb.pruned_blocks(), 3u );
+      for( const auto& b : old_fork )
+         BOOST_CHECK( !fdb.is_known_block( b.id() ) );
+      BOOST_CHECK( fdb.is_known_block( new_fork.id() ) );
+
+      // when still over the limit, only blocks on the branch of head are kept
+      usage = fdb.memory_usage();
+      fdb.set_max_memory( usage - 1 );
+      fdb.prune_forks();
+      BOOST_CHECK_EQUAL( fdb.size(), 6u );
+      BOOST_CHECK_EQUAL( fdb.pruned_blocks(), 4u );
+      BOOST_CHECK( !fdb.is_known_block( new_fork.id() ) );
+      for( uint32_t i = 4; i < 10; ++i )
+         BOOST_CHECK( fdb.is_known_block( main_chain[i].id() ) );
+      BOOST_CHECK( fdb.head()->id == main_chain.back().id() );
+      BOOST_CHECK_EQUAL( fdb.memory_usage(), usage - fc::raw::pack_size( new_fork ) );
+   } FC_LOG_AND_RETHROW()
+}
 
 /**
  *  These test has been disabled, out of order blocks should result in the node getting disconnected.
@@ -1949,4 +2021,41 @@ BOOST_FIXTURE_TEST_CASE( block_size_test, database_fixture )
    }
 }
 
+BOOST_FIXTURE_TEST_CASE( precompute_parallel_signees, database_fixture )
+{
+   try {
+      vector<fc::ecc::private_key> keys;
+      for( uint32_t i = 0; i < 16; ++i )
+         keys.push_back( generate_private_key( "precompute" + std::to_string(i) ) );
+
+      // transactions with very different numbers of signatures, so that the workers go out of step
+      signed_block block;
+      for( uint32_t i = 0; i < 200; ++i )
+      {
+         signed_transaction trx;
+         transfer_operation op;
+         op.to = account_id_type(1);
+         op.amount = asset( i + 1 );
+         trx.operations.push_back( op );
+         trx.set_expiration( db.head_block_time() + fc::minutes(1) );
+         const uint32_t signatures = ( i % 7 == 0 ) ? keys.size() : i % 3 + 1;
+         for( uint32_t k = 0; k < signatures; ++k )
+            trx.sign( keys[ ( i + k ) % keys.size() ], db.get_chain_id() );
+         block.transactions.emplace_back( trx );
+      }
+
+      db.precompute_parallel( block, database::skip_witness_signature | database::skip_merkle_check ).wait();
+
+      for( const auto& trx : block.transactions )
+      {
+         signed_transaction plain( trx );
+         BOOST_CHECK( trx.get_signature_keys( db.get_chain_id() ) == plain.get_signature_keys( db.get_chain_id() ) );
+         BOOST_CHECK_EQUAL( trx.get_signature_keys( db.get_chain_id() ).size(), trx.signatures.size() );
+      }
+   } catch (fc::exception& e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -27,10 +27,13 @@
 #include <graphene/chain/database.hpp>
 
 #include <graphene/chain/account_object.hpp>
+#include <graphene/chain/market_object.hpp>
 #include <graphene/chain/proposal_object.hpp>
 
 #include <fc/crypto/digest.hpp>
 
+#include <future>
+
 #include "../common/database_fixture.hpp"
 
 using namespace graphene::chain;
@@ -223,6 +226,250 @@ BOOST_AUTO_TEST_CASE( direct_index_test )
    // but the secondary has not updated its representation
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( secondary_index_bulk_load_test )
+{ try {
+   using account_primary_index = primary_index< account_index, 20 >;
+   using balance_primary_index = primary_index< account_balance_index >;
+
+   database incremental_db;
+   database bulk_db;
+   for( database* d : { &incremental_db, &bulk_db } )
+   {
+      d->initialize_indexes();
+      d->add_secondary_index< account_primary_index, account_member_index >();
+   }
+
+   // Populate both databases before bulk loading
+   for( database* d : { &incremental_db, &bulk_db } )
+   {
+      for( uint32_t i = 0; i < 60; ++i )
+         d->create<account_object>( [i]( account_object& a ) {
+            a.name = "account" + std::to_string( i );
+            a.owner = authority( 1, account_id_type( (i + 1) % 60 ), 1 );
+            a.active = authority( 1, public_key_type( generate_private_key( a.name ).get_public_key() ), 1 );
+         });
+      for( uint32_t i = 0; i < 150; ++i )
+         d->create<account_balance_object>( [i]( account_balance_object& b ) {
+            b.owner = account_id_type( i % 60 );
+            b.asset_type = asset_id_type( i / 60 );
+            b.balance = i;
+         });
+   }
+
+   bulk_db.begin_bulk_load();
+   BOOST_CHECK_THROW( bulk_db.get_index_type< balance_primary_index >()
+                             .get_secondary_index< balances_by_account_index >(), fc::assert_exception );
+
+   // Apply the same changes to both databases, to objects created before and while bulk loading
+   for( database* d : { &incremental_db, &bulk_db } )
+   {
+      for( uint32_t i = 150; i < 300; ++i )
+         d->create<account_balance_object>( [i]( account_balance_object& b ) {
+            b.owner = account_id_type( i % 60 );
+            b.asset_type = asset_id_type( i / 60 );
+            b.balance = i;
+         });
+      d->modify( account_id_type(3)(*d), []( account_object& a ) {
+         a.owner = authority( 1, account_id_type(9), 1 );
+      });
+      d->modify( account_balance_id_type(5)(*d), []( account_balance_object& b ) {
+         b.balance = 1000;
+      });
+      d->remove( account_balance_id_type(7)(*d) );
+      d->remove( account_balance_id_type(200)(*d) );
+      d->remove( account_id_type(4)(*d) );
+   }
+
+   bulk_db.end_bulk_load();
+
+   // The rebuilt secondary indexes are identical to the incrementally maintained ones
+   const auto& expected_balances = incremental_db.get_index_type< balance_primary_index >()
+                                                .get_secondary_index< balances_by_account_index >();
+   const auto& actual_balances = bulk_db.get_index_type< balance_primary_index >()
+                                        .get_secondary_index< balances_by_account_index >();
+   for( uint32_t i = 0; i < 60; ++i )
+   {
+      const auto& expected = expected_balances.get_account_balances( account_id_type(i) );
+      const auto& actual = actual_balances.get_account_balances( account_id_type(i) );
+      BOOST_REQUIRE_EQUAL( expected.size(), actual.size() );
+      for( auto e = expected.begin(), a = actual.begin(); e != expected.end(); ++e, ++a )
+      {
+         BOOST_CHECK( e->first == a->first );
+         BOOST_CHECK( e->second->id == a->second->id );
+         BOOST_CHECK_EQUAL( e->second->balance.value, a->second->balance.value );
+      }
+   }
+   BOOST_CHECK( actual_balances.get_account_balance( account_id_type(7), asset_id_type(0) ) == nullptr );
+   BOOST_CHECK( actual_balances.get_account_balance( account_id_type(20), asset_id_type(3) ) == nullptr );
+
+   const auto& expected_members = incremental_db.get_index_type< account_primary_index >()
+                                               .get_secondary_index< account_member_index >();
+   const auto& actual_members = bulk_db.get_index_type< account_primary_index >()
+                                       .get_secondary_index< account_member_index >();
+   BOOST_CHECK( expected_members.account_to_account_memberships == actual_members.account_to_account_memberships );
+   BOOST_CHECK( expected_members.account_to_key_memberships == actual_members.account_to_key_memberships );
+   BOOST_CHECK_EQUAL( actual_members.account_to_account_memberships.at( account_id_type(9) ).size(), 2u );
+
+   const auto& direct = bulk_db.get_index_type< account_primary_index >()
+                               .get_secondary_index< graphene::db::direct_index< account_object, 20 > >();
+   for( uint32_t i = 0; i < 61; ++i )
+   {
+      const auto* expected = incremental_db.find( account_id_type(i) );
+      const auto* actual = direct.find( account_id_type(i) );
+      BOOST_REQUIRE_EQUAL( expected == nullptr, actual == nullptr );
+      if( expected != nullptr )
+         BOOST_CHECK_EQUAL( expected->name, actual->name );
+   }
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( secondary_index_handle_test )
+{ try {
+   using balance_primary_index = primary_index< account_balance_index >;
+
+   database bal_db;
+   bal_db.initialize_indexes();
+   const auto& primary = bal_db.get_index_type< balance_primary_index >();
+   const auto handle = primary.get_secondary_index_handle< balances_by_account_index >();
+   BOOST_REQUIRE( handle.valid() );
+   BOOST_CHECK( &*handle == &primary.get_secondary_index< balances_by_account_index >() );
+   BOOST_CHECK( &*handle == &bal_db.get_balances_by_account_index() );
+   BOOST_CHECK_THROW( primary.get_secondary_index_handle< account_member_index >(), fc::assert_exception );
+   BOOST_CHECK_THROW( *secondary_index_handle< balances_by_account_index >(), fc::assert_exception );
+
+   bal_db.adjust_balance( account_id_type(1), asset( 100 ) );
+   BOOST_CHECK_EQUAL( handle->get_account_balance( account_id_type(1), asset_id_type() )->balance.value, 100 );
+   BOOST_CHECK_EQUAL( bal_db.get_balance( account_id_type(1), asset_id_type() ).amount.value, 100 );
+
+   // The handle refuses access while the secondary indexes are stale
+   bal_db.begin_bulk_load();
+   BOOST_CHECK_THROW( *handle, fc::assert_exception );
+   BOOST_CHECK_THROW( bal_db.get_balance( account_id_type(1), asset_id_type() ), fc::assert_exception );
+   bal_db.end_bulk_load();
+   BOOST_CHECK_EQUAL( bal_db.get_balance( account_id_type(1), asset_id_type() ).amount.value, 100 );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( typed_modify_test )
+{ try {
+   using order_primary_index = primary_index< limit_order_index >;
+   const auto& by_expiration = db.get_index_type< limit_order_index >().indices().get< by_expiration >();
+   const auto first_expiration = db.head_block_time() + fc::hours(1);
+
+   const auto& first = db.create_in< order_primary_index >( [first_expiration]( limit_order_object& o ) {
+      o.expiration = first_expiration;
+      o.for_sale = 100;
+   });
+   const auto& second = db.create<limit_order_object>( [first_expiration]( limit_order_object& o ) {
+      o.expiration = first_expiration + fc::hours(1);
+      o.for_sale = 100;
+   });
+   BOOST_CHECK_EQUAL( second.id.instance(), first.id.instance() + 1 );
+
+   {
+      auto session = db._undo_db.start_undo_session();
+      // A change of a key moves the object in the orderings
+      db.modify_in< order_primary_index >( first, []( limit_order_object& o ) {
+         o.expiration += fc::hours(2);
+      });
+      BOOST_CHECK( by_expiration.begin()->id == second.id );
+      // A change of other fields leaves it in place
+      db.modify_in< order_primary_index >( second, []( limit_order_object& o ) {
+         o.for_sale = 50;
+      }, true );
+      BOOST_CHECK_EQUAL( second.for_sale.value, 50 );
+      BOOST_CHECK( by_expiration.begin()->id == second.id );
+   }
+   // Both are undone as usual
+   BOOST_CHECK( by_expiration.begin()->id == first.id );
+   BOOST_CHECK( first.expiration == first_expiration );
+   BOOST_CHECK_EQUAL( second.for_sale.value, 100 );
+
+   // Exceptions thrown by the modifier are passed on
+   BOOST_CHECK_THROW( db.modify_in< order_primary_index >( first, []( limit_order_object& o ) {
+      FC_ASSERT( false );
+   }, true ), fc::assert_exception );
+
+   db.remove( first );
+   db.remove( second );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( balances_by_asset_index_test )
+{ try {
+   const auto& balances = db.get_index_type< account_balance_index >().indices();
+   const auto& by_asset = db.get_index_type< primary_index< account_balance_index > >()
+                            .get_secondary_index< balances_by_asset_index >();
+   const auto check_ordering = [&]() {
+      // ordered by asset, decreasing amount and owner
+      vector< std::tuple< asset_id_type, int64_t, account_id_type > > expected;
+      for( const account_balance_object& b : balances )
+         expected.emplace_back( b.asset_type, -b.balance.value, b.owner );
+      std::sort( expected.begin(), expected.end() );
+      const auto& ordered = by_asset.get_balances_by_asset();
+      BOOST_REQUIRE_EQUAL( ordered.size(), expected.size() );
+      auto e = expected.begin();
+      for( const asset_balance_entry& entry : ordered )
+      {
+         BOOST_CHECK( entry.asset_type == std::get<0>( *e ) );
+         BOOST_CHECK_EQUAL( entry.balance.value, -std::get<1>( *e ) );
+         BOOST_CHECK( entry.owner == std::get<2>( *e ) );
+         ++e;
+      }
+   };
+
+   check_ordering();
+   for( uint32_t i = 0; i < 20; ++i )
+      db.adjust_balance( account_id_type( 100 + i ), asset( 1000 - i ) );
+   check_ordering();
+
+   {
+      auto session = db._undo_db.start_undo_session();
+      for( uint32_t i = 0; i < 20; ++i )
+      {
+         db.adjust_balance( account_id_type( 100 + i ), asset( i * 7 % 20 ) );
+         db.adjust_balance( account_id_type( 100 + i ), asset( 5, asset_id_type(1) ) );
+         db.adjust_balance( account_id_type( 100 + i ), -asset( i ) );
+      }
+      db.remove( *db.get_balances_by_account_index().get_account_balance( account_id_type(103), asset_id_type() ) );
+      check_ordering();
+      db.remove( *db.get_balances_by_account_index().get_account_balance( account_id_type(104), asset_id_type() ) );
+      db.adjust_balance( account_id_type(105), asset( 50 ) );
+   }
+   // the undone changes are applied without having been seen by a query
+   check_ordering();
+
+   for( uint32_t i = 0; i < 20; ++i )
+      db.adjust_balance( account_id_type( 100 + i ), -asset( 1000 - i ) );
+   check_ordering();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( maintenance_flag_test )
+{ try {
+   ACTORS( (alice)(bob) );
+   generate_blocks( db.get_dynamic_global_properties().next_maintenance_time );
+   BOOST_CHECK_EQUAL( alice_id(db).statistics(db).core_in_balance.value, 0 );
+
+   transfer( committee_account, alice_id, asset(1000) );
+   generate_block();
+   transfer( alice_id, bob_id, asset(400) );
+   generate_block();
+   BOOST_CHECK_EQUAL( alice_id(db).statistics(db).core_in_balance.value, 0 );
+   BOOST_CHECK( db.get_balances_by_account_index().get_account_balance( alice_id, asset_id_type() )->maintenance_flag );
+
+   // maintenance brings the statistics up to date and clears the flags
+   generate_blocks( db.get_dynamic_global_properties().next_maintenance_time );
+   BOOST_CHECK_EQUAL( alice_id(db).statistics(db).core_in_balance.value, 600 );
+   BOOST_CHECK_EQUAL( bob_id(db).statistics(db).core_in_balance.value, 400 );
+   BOOST_CHECK( !db.get_balances_by_account_index().get_account_balance( alice_id, asset_id_type() )->maintenance_flag );
+   BOOST_CHECK( !db.get_balances_by_account_index().get_account_balance( bob_id, asset_id_type() )->maintenance_flag );
+
+   // undoing the maintenance block flags the balances again, and they are processed when it is applied again
+   const signed_block maintenance_block = *db.fetch_block_by_number( db.head_block_num() );
+   db.pop_block();
+   BOOST_CHECK( db.get_balances_by_account_index().get_account_balance( alice_id, asset_id_type() )->maintenance_flag );
+   PUSH_BLOCK( db, maintenance_block );
+   BOOST_CHECK_EQUAL( alice_id(db).statistics(db).core_in_balance.value, 600 );
+   BOOST_CHECK( !db.get_balances_by_account_index().get_account_balance( alice_id, asset_id_type() )->maintenance_flag );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE( required_approval_index_test ) // see https://github.com/bitshares/bitshares-core/issues/1719
 { try {
    ACTORS( (alice)(bob)(charlie)(agnetha)(benny)(carlos) );
@@ -310,4 +557,115 @@ BOOST_AUTO_TEST_CASE( required_approval_index_test ) // see https://github.com/b
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( deferred_object_changes_test )
+{ try {
+   ACTORS( (alice)(bob) );
+   fund( alice, asset(1000000) );
+   generate_block();
+
+   std::mutex mutex;
+   flat_set<object_id_type> changed_ids;
+   flat_set<account_id_type> changed_accounts;
+   uint32_t fast_id = db.deferred_object_changes.subscribe( "fast",
+         [&mutex,&changed_ids,&changed_accounts]( const object_change_set& changes ) {
+      std::lock_guard<std::mutex> guard( mutex );
+      for( const auto& obj : changes.changed_objects )
+         changed_ids.insert( obj->id );
+      const auto& accounts = changes.changed_accounts_impacted();
+      changed_accounts.insert( accounts.begin(), accounts.end() );
+   });
+   // the slow subscriber is held in its first delivery until released, its queue takes one more change set
+   std::promise<void> release;
+   std::shared_future<void> released = release.get_future().share();
+   uint32_t slow_id = db.deferred_object_changes.subscribe( "slow", [released]( const object_change_set& ) {
+      released.wait();
+   }, 1 );
+   db.deferred_object_changes.set_slow_threshold( fc::microseconds(0) );
+
+   flat_set<account_id_type> sync_changed_accounts;
+   boost::signals2::scoped_connection sync_connection = db.changed_objects.connect(
+         [&sync_changed_accounts]( const vector<object_id_type>&, const flat_set<account_id_type>& accounts ) {
+      sync_changed_accounts.insert( accounts.begin(), accounts.end() );
+   });
+
+   transfer( alice_id, bob_id, asset(1000) );
+   for( int i = 0; i < 5; ++i )
+      generate_block();
+   release.set_value();
+   db.deferred_object_changes.flush();
+
+   {
+      std::lock_guard<std::mutex> guard( mutex );
+      const auto& bal_idx = db.get_index_type< primary_index< account_balance_index > >()
+                               .get_secondary_index< balances_by_account_index >();
+      BOOST_CHECK( changed_ids.count( bal_idx.get_account_balance( alice_id, asset_id_type() )->id ) > 0 );
+      BOOST_CHECK( changed_accounts.count( alice_id ) > 0 );
+      BOOST_CHECK( changed_accounts.count( bob_id ) > 0 );
+      // both paths report the same impacted accounts
+      BOOST_CHECK( changed_accounts == sync_changed_accounts );
+   }
+
+   auto stats = db.deferred_object_changes.get_stats();
+   BOOST_REQUIRE_EQUAL( stats.size(), 2u );
+   const auto& fast_stats = stats[0].name == "fast" ? stats[0] : stats[1];
+   const auto& slow_stats = stats[0].name == "slow" ? stats[0] : stats[1];
+   BOOST_CHECK_EQUAL( fast_stats.delivered, 5u );
+   BOOST_CHECK_EQUAL( fast_stats.dropped, 0u );
+   BOOST_CHECK_EQUAL( fast_stats.queue_size, 0u );
+   // one change set was held, at most one more was queued
+   BOOST_CHECK_LE( slow_stats.delivered, 2u );
+   BOOST_CHECK_GE( slow_stats.dropped, 3u );
+   BOOST_CHECK_GT( slow_stats.slow, 0u );
+   BOOST_CHECK_EQUAL( slow_stats.delivered + slow_stats.dropped, fast_stats.delivered );
+
+   db.deferred_object_changes.unsubscribe( fast_id );
+   db.deferred_object_changes.unsubscribe( slow_id );
+   BOOST_CHECK( !db.deferred_object_changes.has_subscribers() );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( state_digest_test )
+{ try {
+   BOOST_CHECK( !db.get_state_digest().valid() );
+   db.enable_state_digest( true );
+   BOOST_REQUIRE( db.get_state_digest().valid() );
+   const fc::sha256 initial = *db.get_state_digest();
+
+   ACTORS( (alice)(bob) );
+   transfer( committee_account, alice_id, asset(1000) );
+   generate_block();
+   const fc::sha256 after_transfer = *db.get_state_digest();
+   BOOST_CHECK( after_transfer != initial );
+
+   // the incrementally maintained digest is the one computed from scratch
+   db.enable_state_digest( false );
+   BOOST_CHECK( !db.get_state_digest().valid() );
+   db.enable_state_digest( true );
+   BOOST_CHECK( *db.get_state_digest() == after_transfer );
+
+   // undoing changes restores the digest
+   {
+      auto session = db._undo_db.start_undo_session();
+      db.modify( alice_id(db), []( account_object& a ) { a.name = "carol"; } );
+      db.remove( bob_id(db) );
+      db.create<account_balance_object>( [alice_id]( account_balance_object& b ) {
+         b.owner = alice_id;
+         b.asset_type = asset_id_type(1);
+      });
+      BOOST_CHECK( *db.get_state_digest() != after_transfer );
+   }
+   BOOST_CHECK( *db.get_state_digest() == after_transfer );
+
+   // so does popping a block, and applying it again leads to the same state
+   const signed_block b = generate_block();
+   const fc::sha256 after_block = *db.get_state_digest();
+   BOOST_CHECK( after_block != after_transfer );
+   db.pop_block();
+   BOOST_CHECK( *db.get_state_digest() == after_transfer );
+   PUSH_BLOCK( db, b );
+   BOOST_CHECK( *db.get_state_digest() == after_block );
+
+   db.enable_state_digest( false );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/es_objects/es_objects.hpp>
+
+#include "../common/database_fixture.hpp"
+#include "../common/es_stand_in.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+BOOST_FIXTURE_TEST_SUITE( es_objects_tests, database_fixture )
+
+BOOST_AUTO_TEST_CASE( es_objects_bulk_stand_in )
+{ try {
+   BOOST_REQUIRE( es_stand_in_server );
+
+   ACTORS( (alice)(bob) );
+   fund( alice, asset(1000000) );
+   generate_block();
+
+   // modify the same balance objects in many blocks
+   for( int i = 0; i < 5; ++i )
+   {
+      transfer( alice_id, bob_id, asset(1000) );
+      generate_block();
+   }
+
+   // at most the genesis data has been sent so far
+   BOOST_CHECK_LE( es_stand_in_server->bulk_requests(), 1u );
+   const uint32_t bulk_requests = es_stand_in_server->bulk_requests();
+   es_stand_in_server->clear_bulk_lines();
+
+   // sends the pending objects in one bulk and waits for the sender
+   app.get_plugin<graphene::es_objects::es_objects_plugin>( "es_objects" )->plugin_shutdown();
+   BOOST_CHECK_EQUAL( es_stand_in_server->bulk_requests(), bulk_requests + 1 );
+
+   const auto& bal_idx = db.get_index_type< primary_index< account_balance_index > >()
+                            .get_secondary_index< balances_by_account_index >();
+   const string alice_balance_id = string( bal_idx.get_account_balance( alice_id, asset_id_type() )->id );
+
+   uint32_t documents = 0;
+   fc::variant last_document;
+   const auto lines = es_stand_in_server->bulk_lines();
+   for( size_t i = 0; i + 1 < lines.size(); ++i )
+   {
+      fc::variant header = fc::json::from_string( lines[i] );
+      if( !header.get_object().contains( "index" ) )
+         continue;
+      fc::variant document = fc::json::from_string( lines[++i] );
+      if( document["object_id"].as_string() == alice_balance_id )
+      {
+         ++documents;
+         last_document = document;
+      }
+   }
+
+   // one document for all modifications, with the current state
+   BOOST_REQUIRE_EQUAL( documents, 1u );
+   BOOST_CHECK_EQUAL( last_document["balance"].as_string(),
+                      fc::to_string( db.get_balance( alice_id, asset_id_type() ).amount.value ) );
+   BOOST_CHECK_EQUAL( last_document["block_number"].as_uint64(), db.head_block_num() );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( es_objects_bulk_failure )
+{ try {
+   BOOST_REQUIRE( es_stand_in_server );
+
+   ACTORS( (alice)(bob) );
+   fund( alice, asset(1000000) );
+   generate_block();
+
+   es_stand_in_server->set_failing( true );
+
+   // the bulk of this block is handed over to the sender and fails there
+   transfer( alice_id, bob_id, asset(1000) );
+   generate_block();
+
+   // the failure is raised when the next bulk waits for the sender
+   transfer( alice_id, bob_id, asset(1000) );
+   GRAPHENE_REQUIRE_THROW( generate_block(), graphene::chain::plugin_exception );
+
+   // once ES is back, the lines of the failed bulk are sent in front of the next bulk
+   es_stand_in_server->set_failing( false );
+   es_stand_in_server->clear_bulk_lines();
+   transfer( alice_id, bob_id, asset(1000) );
+   generate_block();
+   app.get_plugin<graphene::es_objects::es_objects_plugin>( "es_objects" )->plugin_shutdown();
+
+   const auto& bal_idx = db.get_index_type< primary_index< account_balance_index > >()
+                            .get_secondary_index< balances_by_account_index >();
+   const string alice_balance_id = string( bal_idx.get_account_balance( alice_id, asset_id_type() )->id );
+
+   uint32_t documents = 0;
+   fc::variant last_document;
+   const auto lines = es_stand_in_server->bulk_lines();
+   for( size_t i = 0; i + 1 < lines.size(); ++i )
+   {
+      fc::variant header = fc::json::from_string( lines[i] );
+      if( !header.get_object().contains( "index" ) )
+         continue;
+      fc::variant document = fc::json::from_string( lines[++i] );
+      if( document["object_id"].as_string() == alice_balance_id )
+      {
+         ++documents;
+         last_document = document;
+      }
+   }
+
+   // the failed bulk and the following one
+   BOOST_CHECK_GE( documents, 2u );
+   BOOST_CHECK_EQUAL( last_document["balance"].as_string(),
+                      fc::to_string( db.get_balance( alice_id, asset_id_type() ).amount.value ) );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
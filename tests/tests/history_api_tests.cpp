@@ -28,6 +28,8 @@
 
 #include <graphene/chain/hardfork.hpp>
 
+#include <graphene/market_history/fill_store.hpp>
+
 #include <graphene/utilities/tempdir.hpp>
 
 #include <fc/crypto/digest.hpp>
@@ -834,4 +836,298 @@ BOOST_AUTO_TEST_CASE(api_limit_get_account_history_by_operations) {
 }
 
 
+BOOST_AUTO_TEST_CASE(get_market_history_from_fill_store) {
+   try {
+      graphene::app::history_api hist_api(app);
+
+      const auto* store = app.get_plugin<graphene::market_history::market_history_plugin>( "market_history" )
+                             ->get_fill_store();
+      BOOST_REQUIRE( store != nullptr );
+
+      const asset_object& test = create_user_issued_asset( "UIATEST" );
+      const asset_id_type test_id = test.id;
+      const asset_id_type core_id;
+      const account_object& seller = create_account( "seller1" );
+      const account_object& buyer = create_account( "buyer1" );
+      transfer( committee_account(db), seller, asset( 100000000 ) );
+      issue_uia( buyer, asset( 10000000, test_id ) );
+      generate_block();
+
+      create_sell_order( seller, asset( 100 ), asset( 200, test_id ) );
+      create_sell_order( buyer, asset( 200, test_id ), asset( 100 ) );
+      generate_block();
+      const auto first_time = db.head_block_time();
+
+      generate_blocks( db.head_block_time() + 60 );
+      create_sell_order( seller, asset( 100 ), asset( 300, test_id ) );
+      create_sell_order( buyer, asset( 300, test_id ), asset( 100 ) );
+      generate_block();
+      const auto second_time = db.head_block_time();
+
+      // no buckets are tracked in the object database
+      BOOST_CHECK_EQUAL( db.get_index_type<graphene::market_history::bucket_index>().indices().size(), 0u );
+
+      // no order history is kept in the object database
+      BOOST_CHECK_EQUAL( db.get_index_type<graphene::market_history::history_index>().indices().size(), 0u );
+
+      // fills are numbered like in the order history index, the maker is the seller
+      auto fills = hist_api.get_fill_order_history( "UIATEST", GRAPHENE_SYMBOL, 100 );
+      BOOST_REQUIRE_EQUAL( fills.size(), 4u );
+      for( size_t i = 0; i < fills.size(); ++i )
+      {
+         BOOST_CHECK( fills[i].key.base == core_id );
+         BOOST_CHECK( fills[i].key.quote == test_id );
+         BOOST_CHECK_EQUAL( fills[i].key.sequence, int64_t(i) - 3 );
+         BOOST_CHECK( fills[i].time == ( i < 2 ? second_time : first_time ) );
+         const int64_t test_amount = ( i < 2 ? 300 : 200 );
+         if( fills[i].op.is_maker )
+         {
+            BOOST_CHECK( fills[i].op.account_id == seller.get_id() );
+            BOOST_CHECK( fills[i].op.pays == asset( 100 ) );
+            BOOST_CHECK( fills[i].op.receives == asset( test_amount, test_id ) );
+         }
+         else
+         {
+            BOOST_CHECK( fills[i].op.account_id == buyer.get_id() );
+            BOOST_CHECK( fills[i].op.pays == asset( test_amount, test_id ) );
+            BOOST_CHECK( fills[i].op.receives == asset( 100 ) );
+         }
+      }
+      BOOST_CHECK_EQUAL( fills[0].op.is_maker + fills[1].op.is_maker, 1 );
+      BOOST_CHECK_EQUAL( fills[2].op.is_maker + fills[3].op.is_maker, 1 );
+      BOOST_CHECK_EQUAL( hist_api.get_fill_order_history( GRAPHENE_SYMBOL, "UIATEST", 3 ).size(), 3u );
+
+      // trade history is served from the store too
+      graphene::app::database_api db_api( db, &( app.get_options() ) );
+      auto trades = db_api.get_trade_history( GRAPHENE_SYMBOL, "UIATEST", second_time, fc::time_point_sec(), 10 );
+      BOOST_REQUIRE_EQUAL( trades.size(), 2u );
+      BOOST_CHECK( trades[0].date == second_time );
+      BOOST_CHECK( trades[0].side1_account_id == seller.get_id() );
+      BOOST_CHECK( trades[0].side2_account_id == buyer.get_id() );
+      BOOST_CHECK( trades[1].date == first_time );
+      BOOST_CHECK( trades[1].sequence < trades[0].sequence );
+      BOOST_CHECK_EQUAL( db_api.get_trade_history( GRAPHENE_SYMBOL, "UIATEST", second_time, second_time, 10 ).size(),
+                         1u );
+      BOOST_CHECK_EQUAL( db_api.get_trade_history( GRAPHENE_SYMBOL, "UIATEST", first_time, fc::time_point_sec(), 10 )
+                            .size(), 1u );
+      trades = db_api.get_trade_history_by_sequence( GRAPHENE_SYMBOL, "UIATEST", trades[0].sequence,
+                                                     fc::time_point_sec(), 10 );
+      BOOST_REQUIRE_EQUAL( trades.size(), 1u );
+      BOOST_CHECK( trades[0].date == first_time );
+
+      // buckets of a size which is not configured in bucket-size are rolled up from the maker fills
+      auto buckets = hist_api.get_market_history( GRAPHENE_SYMBOL, "UIATEST", 10, fc::time_point_sec(),
+                                                  second_time );
+      BOOST_REQUIRE_EQUAL( buckets.size(), 2u );
+      BOOST_CHECK( buckets[0].key.base == core_id );
+      BOOST_CHECK( buckets[0].key.quote == test_id );
+      BOOST_CHECK_EQUAL( buckets[0].key.seconds, 10u );
+      BOOST_CHECK( buckets[0].key.open == fc::time_point_sec( first_time.sec_since_epoch() / 10 * 10 ) );
+      BOOST_CHECK_EQUAL( buckets[0].base_volume.value, 100 );
+      BOOST_CHECK_EQUAL( buckets[0].quote_volume.value, 200 );
+      BOOST_CHECK_EQUAL( buckets[0].open_base.value, 100 );
+      BOOST_CHECK_EQUAL( buckets[0].open_quote.value, 200 );
+      BOOST_CHECK( buckets[1].key.open == fc::time_point_sec( second_time.sec_since_epoch() / 10 * 10 ) );
+      BOOST_CHECK_EQUAL( buckets[1].base_volume.value, 100 );
+      BOOST_CHECK_EQUAL( buckets[1].quote_volume.value, 300 );
+      BOOST_CHECK_EQUAL( buckets[1].close_base.value, 100 );
+      BOOST_CHECK_EQUAL( buckets[1].close_quote.value, 300 );
+
+      // the time range applies to bucket open times
+      buckets = hist_api.get_market_history( GRAPHENE_SYMBOL, "UIATEST", 10, first_time + 10, second_time );
+      BOOST_REQUIRE_EQUAL( buckets.size(), 1u );
+      BOOST_CHECK_EQUAL( buckets[0].quote_volume.value, 300 );
+
+      // a bucket covering both fills
+      buckets = hist_api.get_market_history( GRAPHENE_SYMBOL, "UIATEST", 86400 * 1000, fc::time_point_sec(),
+                                             second_time );
+      BOOST_REQUIRE_EQUAL( buckets.size(), 1u );
+      BOOST_CHECK_EQUAL( buckets[0].base_volume.value, 200 );
+      BOOST_CHECK_EQUAL( buckets[0].quote_volume.value, 500 );
+      BOOST_CHECK_EQUAL( buckets[0].high_base.value, 100 );
+      BOOST_CHECK_EQUAL( buckets[0].high_quote.value, 200 );
+      BOOST_CHECK_EQUAL( buckets[0].low_base.value, 100 );
+      BOOST_CHECK_EQUAL( buckets[0].low_quote.value, 300 );
+
+      // fills are rolled out of the ticker a day later
+      const auto& ticker_idx = db.get_index_type<graphene::market_history::market_ticker_index>()
+                                  .indices().get<graphene::market_history::by_market>();
+      auto ticker_volume = [&]() {
+         auto itr = ticker_idx.find( std::make_tuple( core_id, test_id ) );
+         BOOST_REQUIRE( itr != ticker_idx.end() );
+         return itr->quote_volume;
+      };
+      BOOST_CHECK( ticker_volume() == 500 );
+      generate_blocks( first_time + 86400 + 10 );
+      BOOST_CHECK( ticker_volume() == 300 );
+      generate_blocks( second_time + 86400 + 10 );
+      BOOST_CHECK( ticker_volume() == 0 );
+   } catch (fc::exception &e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE(fill_store_revert_and_reopen) {
+   try {
+      using graphene::market_history::fill_store;
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+
+      const asset_id_type core_id;
+      const asset_id_type test_id( 1 );
+      const fc::time_point_sec t0( 86400 * 1000 - 3 );
+      auto make_fill = [&]( int64_t core_amount, int64_t test_amount ) {
+         return fill_order_operation( limit_order_id_type( 1 ), account_id_type( 17 ), asset( core_amount ),
+                                      asset( test_amount, test_id ), asset(),
+                                      price( asset( core_amount ), asset( test_amount, test_id ) ), true );
+      };
+
+      {
+         fill_store store;
+         store.open( data_dir.path(), 1 );
+         store.push_block( 1, t0, { make_fill( 1, 2 ) } );
+         store.push_block( 2, t0 + 3, { make_fill( 1, 3 ), make_fill( 1, 4 ) } );
+         store.set_last_irreversible_block( 1 );
+         BOOST_CHECK_EQUAL( store.size(), 1u );
+
+         // block 2 is reverted and replaced
+         store.push_block( 2, t0 + 3, { make_fill( 1, 5 ) } );
+         store.push_block( 3, t0 + 6, {} );
+         store.set_last_irreversible_block( 3 );
+         BOOST_CHECK_EQUAL( store.size(), 2u );
+
+         auto fills = store.get_fills( test_id, core_id, 10 );
+         BOOST_REQUIRE_EQUAL( fills.size(), 2u );
+         BOOST_CHECK( fills[0].op.receives == asset( 5, test_id ) );
+         BOOST_CHECK_EQUAL( fills[0].key.sequence, -1 );
+         BOOST_CHECK( fills[1].op.receives == asset( 2, test_id ) );
+         BOOST_CHECK_EQUAL( fills[1].key.sequence, 0 );
+
+         // the fills are in different partitions
+         auto buckets = store.get_buckets( core_id, test_id, 86400 * 2, fc::time_point_sec(), t0 + 6, 200 );
+         BOOST_REQUIRE_EQUAL( buckets.size(), 2u );
+      }
+
+      {
+         // reopened as if block 2 was to be replayed
+         fill_store store;
+         store.open( data_dir.path(), 2 );
+         BOOST_CHECK_EQUAL( store.size(), 1u );
+         store.push_block( 2, t0 + 3, { make_fill( 1, 6 ) } );
+         store.set_last_irreversible_block( 2 );
+      }
+
+      {
+         fill_store store;
+         store.open( data_dir.path(), 3 );
+         auto fills = store.get_fills( core_id, test_id, 10 );
+         BOOST_REQUIRE_EQUAL( fills.size(), 2u );
+         BOOST_CHECK( fills[0].op.receives == asset( 6, test_id ) );
+         BOOST_CHECK( fills[0].time == t0 + 3 );
+         BOOST_CHECK( fills[1].op.receives == asset( 2, test_id ) );
+         BOOST_CHECK( fills[1].op.fill_price == price( asset( 1 ), asset( 2, test_id ) ) );
+      }
+   } catch (fc::exception &e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+
+BOOST_AUTO_TEST_CASE(fill_store_old_windows_on_disk) {
+   try {
+      using graphene::market_history::fill_store;
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+
+      const asset_id_type core_id;
+      const asset_id_type test_id( 1 );
+      const asset_id_type other_id( 2 );
+      const fc::time_point_sec t0( 86400 * 1000 );
+      auto make_fill = [&]( asset_id_type quote_id, int64_t core_amount, int64_t quote_amount ) {
+         return fill_order_operation( limit_order_id_type( 1 ), account_id_type( 17 ), asset( core_amount ),
+                                      asset( quote_amount, quote_id ), asset(),
+                                      price( asset( core_amount ), asset( quote_amount, quote_id ) ), true );
+      };
+      // fills of block i are at t0 + 3 * i
+      const uint32_t blocks = 30;
+      auto check_test_fills = [&]( const fill_store& store, uint32_t first_replaced_block ) {
+         auto receives = [first_replaced_block]( uint32_t i ) {
+            return int64_t( i < first_replaced_block ? i : 100 + i );
+         };
+         auto fills = store.get_fills( test_id, core_id, 100 );
+         BOOST_REQUIRE_EQUAL( fills.size(), blocks );
+         for( uint32_t k = 0; k < blocks; ++k )
+         {
+            BOOST_CHECK( fills[k].op.receives == asset( receives( blocks - k ), test_id ) );
+            BOOST_CHECK_EQUAL( fills[k].key.sequence, int64_t(k) + 1 - blocks );
+            BOOST_CHECK( fills[k].time == t0 + 3 * ( blocks - k ) );
+         }
+         // a time range in stored windows
+         fills = store.get_fills( test_id, core_id, 100, t0 + 30, t0 + 15 );
+         BOOST_REQUIRE_EQUAL( fills.size(), 6u );
+         BOOST_CHECK( fills.front().op.receives == asset( receives( 10 ), test_id ) );
+         BOOST_CHECK( fills.back().op.receives == asset( receives( 5 ), test_id ) );
+         // the oldest fills by sequence
+         fills = store.get_fills( test_id, core_id, 100, fc::time_point_sec::maximum(), fc::time_point_sec(), -5 );
+         BOOST_REQUIRE_EQUAL( fills.size(), 6u );
+         BOOST_CHECK( fills.front().op.receives == asset( receives( 6 ), test_id ) );
+         BOOST_CHECK_EQUAL( fills.back().key.sequence, 0 );
+         // buckets across stored and recent windows
+         auto buckets = store.get_buckets( core_id, test_id, 30, t0, t0 + 90, 100 );
+         BOOST_REQUIRE_EQUAL( buckets.size(), 4u );
+         BOOST_CHECK_EQUAL( buckets[0].base_volume.value, 9 );
+         BOOST_CHECK_EQUAL( buckets[0].quote_volume.value, 45 );
+         BOOST_CHECK_EQUAL( buckets[3].quote_volume.value, receives( 30 ) );
+         // time ranges of all markets, from disk and from memory
+         uint32_t count = 0;
+         store.for_each_fill( t0, t0 + 30, [&count]( fc::time_point_sec, const fill_order_operation& ) { ++count; } );
+         BOOST_CHECK_EQUAL( count, 18u );
+         count = 0;
+         store.for_each_fill( t0 + 75, t0 + 100,
+                              [&count]( fc::time_point_sec, const fill_order_operation& ) { ++count; } );
+         BOOST_CHECK_EQUAL( count, 12u );
+      };
+
+      {
+         // windows of 10 seconds, only those ending less than 20 seconds before the newest fill stay in memory
+         fill_store store( 10, 20 );
+         store.open( data_dir.path(), 1 );
+         for( uint32_t i = 1; i <= blocks; ++i )
+         {
+            store.push_block( i, t0 + 3 * i, { make_fill( test_id, 1, i ), make_fill( other_id, 2, i ) } );
+            store.set_last_irreversible_block( i );
+         }
+         BOOST_CHECK_EQUAL( store.size(), 2 * blocks );
+         // blocks 24 to 30, in the windows starting at t0 + 70, t0 + 80 and t0 + 90
+         BOOST_CHECK_EQUAL( store.recent_size(), 14u );
+         check_test_fills( store, blocks + 1 );
+      }
+
+      {
+         // reopened as if block 12 and later were to be replayed, the window of block 12 is stored already
+         fill_store store( 10, 20 );
+         store.open( data_dir.path(), 12 );
+         BOOST_CHECK_EQUAL( store.size(), 22u );
+         BOOST_CHECK_EQUAL( store.recent_size(), 4u );
+         for( uint32_t i = 12; i <= blocks; ++i )
+         {
+            store.push_block( i, t0 + 3 * i, { make_fill( test_id, 1, 100 + i ), make_fill( other_id, 2, i ) } );
+            store.set_last_irreversible_block( i );
+         }
+         check_test_fills( store, 12 );
+      }
+
+      {
+         fill_store store( 10, 20 );
+         store.open( data_dir.path(), blocks + 1 );
+         BOOST_CHECK_EQUAL( store.size(), 2 * blocks );
+         BOOST_CHECK_EQUAL( store.recent_size(), 14u );
+         check_test_fills( store, 12 );
+      }
+   } catch (fc::exception &e) {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
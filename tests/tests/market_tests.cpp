@@ -2459,4 +2459,58 @@ BOOST_AUTO_TEST_CASE(mcfr_rounding_test_after2481)
 
 } FC_LOG_AND_RETHROW() }
 
+/***
+ * Tests the check on the least collateralized call order which lets check_call_orders() skip the order books
+ */
+BOOST_AUTO_TEST_CASE(call_orders_trigger_check_test)
+{ try {
+   generate_blocks(HARDFORK_CORE_2481_TIME);
+   set_expiration( db, trx );
+
+   ACTORS((borrower)(feedproducer));
+
+   const auto& bitusd = create_bitasset("USDBIT", feedproducer_id);
+   const auto& core   = asset_id_type()(db);
+   const asset_bitasset_data_object& bitusd_data = bitusd.bitasset_data(db);
+
+   transfer(committee_account, borrower_id, asset(1000000));
+   update_feed_producers( bitusd, {feedproducer.id} );
+
+   // no feed
+   BOOST_CHECK( !db.call_orders_may_be_triggered( bitusd_data ) );
+
+   price_feed current_feed;
+   current_feed.maintenance_collateral_ratio = 1750;
+   current_feed.maximum_short_squeeze_ratio = 1100;
+   current_feed.settlement_price = bitusd.amount( 1 ) / core.amount(5);
+   publish_feed( bitusd, feedproducer, current_feed );
+
+   // no call order
+   BOOST_CHECK( !db.call_orders_may_be_triggered( bitusd_data ) );
+
+   // 300% collateral, call price is 15/1.75 CORE/USD
+   call_order_id_type call_id = borrow( borrower, bitusd.amount(1000), asset(15000) )->id;
+   BOOST_CHECK( !db.call_orders_may_be_triggered( bitusd_data ) );
+   BOOST_CHECK( !db.check_call_orders( bitusd, true, false, &bitusd_data ) );
+
+   // a limit order selling USD does not change anything while the feed protects the call order
+   limit_order_id_type sell_id = create_sell_order( borrower, bitusd.amount(100), core.amount(500) )->id;
+   BOOST_CHECK( !db.call_orders_may_be_triggered( bitusd_data ) );
+   cancel_limit_order( sell_id(db) );
+
+   // the call order falls below the maintenance collateralization, 15 < 10 * 1.75
+   current_feed.settlement_price = bitusd.amount( 1 ) / core.amount(10);
+   publish_feed( bitusd, feedproducer, current_feed );
+   BOOST_CHECK( db.call_orders_may_be_triggered( bitusd_data ) );
+   // nothing to match with, the call order stays
+   BOOST_CHECK( db.find( call_id ) );
+   BOOST_CHECK( !bitusd_data.has_settlement() );
+
+   // protected again
+   current_feed.settlement_price = bitusd.amount( 1 ) / core.amount(5);
+   publish_feed( bitusd, feedproducer, current_feed );
+   BOOST_CHECK( !db.call_orders_may_be_triggered( bitusd_data ) );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
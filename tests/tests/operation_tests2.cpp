@@ -1790,6 +1790,53 @@ BOOST_AUTO_TEST_CASE( balance_object_test )
    BOOST_CHECK_EQUAL(db.get_balance(op.deposit_to_account, asset_id_type()).amount.value, 901);
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( genesis_balances_test )
+{ try {
+   // Enough balances to be built in several parallel chunks; they must lead to the state that
+   // creating them one by one in genesis order gives
+   const uint32_t handouts = 5000;
+   const uint32_t vestings = 3000;
+   auto make_address = []( uint32_t i ) {
+      address a;
+      a.addr = fc::ripemd160::hash( std::to_string(i) );
+      return a;
+   };
+   share_type total;
+   for( uint32_t i = 0; i < handouts; ++i )
+   {
+      genesis_state.initial_balances.push_back( { make_address(i), GRAPHENE_SYMBOL, share_type( i + 1 ) } );
+      total += i + 1;
+   }
+   for( uint32_t i = 0; i < vestings; ++i )
+   {
+      genesis_state_type::initial_vesting_balance_type vest;
+      vest.owner = make_address( handouts + i );
+      vest.asset_symbol = GRAPHENE_SYMBOL;
+      vest.amount = i + 1;
+      vest.begin_balance = vest.amount;
+      vest.begin_timestamp = genesis_state.initial_timestamp + i;
+      vest.vesting_duration_seconds = 60 + i;
+      genesis_state.initial_vesting_balances.push_back( vest );
+      total += i + 1;
+   }
+
+   database serial_db;
+   fc::temp_directory serial_td( graphene::utilities::temp_directory_path() );
+   serial_db.enable_parallel_genesis( false );
+   serial_db.open(serial_td.path(), [this]{return genesis_state;}, "TEST");
+   serial_db.enable_state_digest( true );
+
+   database parallel_db;
+   fc::temp_directory parallel_td( graphene::utilities::temp_directory_path() );
+   parallel_db.open(parallel_td.path(), [this]{return genesis_state;}, "TEST");
+   parallel_db.enable_state_digest( true );
+
+   BOOST_CHECK_EQUAL( parallel_db.get_index_type<balance_index>().indices().size(), handouts + vestings );
+   BOOST_CHECK( parallel_db.get_index_type<balance_index>().get_next_id() == balance_id_type( handouts + vestings ) );
+   BOOST_CHECK_EQUAL( parallel_db.get_core_dynamic_data().current_supply.value, total.value );
+   BOOST_CHECK( *parallel_db.get_state_digest() == *serial_db.get_state_digest() );
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_CASE(transfer_with_memo) {
    try {
       ACTOR(alice);